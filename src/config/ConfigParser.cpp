@@ -35,6 +35,25 @@ bool ConfigParser::parseColor(const std::string &block, COLORREF &color, std::ui
     return true;
 }
 
+bool ConfigParser::parseUpdateCycle(const std::string &block, int &milliseconds, std::uint32_t line, int unit) {
+    try {
+        const auto value = static_cast<long long>(std::stoi(block)) * unit;
+        if (value < core::minUpdateCycleMilliseconds || value > core::maxUpdateCycleMilliseconds) {
+            this->m_errorLine = line;
+            this->m_errorMessage = "Update rate must be between " + std::to_string(core::minUpdateCycleMilliseconds) +
+                                   " and " + std::to_string(core::maxUpdateCycleMilliseconds) + " milliseconds";
+            return false;
+        }
+
+        milliseconds = static_cast<int>(value);
+        return true;
+    } catch (const std::exception &e) {
+        this->m_errorMessage = e.what();
+        this->m_errorLine = line;
+        return false;
+    }
+}
+
 bool ConfigParser::parse(const std::string &filename, PluginConfig &config) {
     config.valid = true;
 
@@ -80,24 +99,74 @@ bool ConfigParser::parse(const std::string &filename, PluginConfig &config) {
         if ("SERVER_url" == values[0]) {
             config.serverUrl = values[1];
             parsed = true;
+        } else if ("SERVER_mirrors" == values[0]) {
+            // comma-separated list of base urls
+            config.serverMirrors.clear();
+            for (const auto &mirror : utils::String::splitString(values[1], ",")) {
+                const auto url = utils::String::trim(mirror);
+                if (false == url.empty()) config.serverMirrors.push_back(url);
+            }
+            parsed = true;
         } else if ("UPDATE_RATE_SECONDS" == values[0]) {
+            // kept for existing configurations, UPDATE_RATE_MILLISECONDS allows a finer cadence
+            parsed = this->parseUpdateCycle(values[1], config.updateCycleMilliseconds, lineOffset, 1000);
+        } else if ("UPDATE_RATE_MILLISECONDS" == values[0]) {
+            parsed = this->parseUpdateCycle(values[1], config.updateCycleMilliseconds, lineOffset);
+        } else if ("UPDATE_RATE_MIN_MILLISECONDS" == values[0]) {
+            parsed = this->parseUpdateCycle(values[1], config.minUpdateCycleMilliseconds, lineOffset);
+        } else if ("UPDATE_RATE_MAX_MILLISECONDS" == values[0]) {
+            parsed = this->parseUpdateCycle(values[1], config.maxUpdateCycleMilliseconds, lineOffset);
+        } else if ("UPDATE_RATE_ADAPTIVE" == values[0]) {
+            if ("true" == values[1] || "false" == values[1]) {
+                config.adaptiveUpdateCycle = "true" == values[1];
+                parsed = true;
+            } else {
+                this->m_errorLine = lineOffset;
+                this->m_errorMessage = "Value must be true or false";
+            }
+        } else if ("RECONCILIATION_SECONDS" == values[0]) {
             try {
-                const int updateCycleSeconds = std::stoi(values[1]);
-                if (updateCycleSeconds < core::minUpdateCycleSeconds ||
-                    updateCycleSeconds > core::maxUpdateCycleSeconds) {
+                const int reconciliationSeconds = std::stoi(values[1]);
+                if (reconciliationSeconds < minReconciliationSeconds ||
+                    reconciliationSeconds > maxReconciliationSeconds) {
                     this->m_errorLine = lineOffset;
-                    this->m_errorMessage = "Value must be number between " +
-                                           std::to_string(core::minUpdateCycleSeconds) + " and " +
-                                           std::to_string(core::maxUpdateCycleSeconds);
+                    this->m_errorMessage = "Value must be number between " + std::to_string(minReconciliationSeconds) +
+                                           " and " + std::to_string(maxReconciliationSeconds);
                 } else {
-                    config.updateCycleSeconds = updateCycleSeconds;
+                    config.reconciliationSeconds = reconciliationSeconds;
+                    parsed = true;
+                }
+            } catch (const std::exception &e) {
+                this->m_errorMessage = e.what();
+                this->m_errorLine = lineOffset;
+            }
+        } else if ("PUSH_CHANNEL" == values[0]) {
+            if ("true" == values[1] || "false" == values[1]) {
+                config.pushChannel = "true" == values[1];
+                parsed = true;
+            } else {
+                this->m_errorLine = lineOffset;
+                this->m_errorMessage = "Value must be true or false";
+            }
+        } else if ("PUSH_URL" == values[0]) {
+            config.pushUrl = values[1];
+            parsed = true;
+        } else if ("PUSH_CONSISTENCY_SECONDS" == values[0]) {
+            try {
+                const int pushConsistencySeconds = std::stoi(values[1]);
+                if (pushConsistencySeconds < minPushConsistencySeconds ||
+                    pushConsistencySeconds > maxPushConsistencySeconds) {
+                    this->m_errorLine = lineOffset;
+                    this->m_errorMessage = "Value must be number between " + std::to_string(minPushConsistencySeconds) +
+                                           " and " + std::to_string(maxPushConsistencySeconds);
+                } else {
+                    config.pushConsistencySeconds = pushConsistencySeconds;
                     parsed = true;
                 }
             } catch (const std::exception &e) {
                 this->m_errorMessage = e.what();
                 this->m_errorLine = lineOffset;
             }
-
         } else if ("COLOR_lightgreen" == values[0]) {
             parsed = this->parseColor(values[1], config.lightgreen, lineOffset);
         } else if ("COLOR_lightblue" == values[0]) {
@@ -131,6 +200,12 @@ bool ConfigParser::parse(const std::string &filename, PluginConfig &config) {
         }
     }
 
+    if (config.minUpdateCycleMilliseconds > config.maxUpdateCycleMilliseconds) {
+        this->m_errorLine = 0;
+        this->m_errorMessage = "UPDATE_RATE_MIN_MILLISECONDS must not exceed UPDATE_RATE_MAX_MILLISECONDS";
+        return false;
+    }
+
     config.valid = true;
     return true;
 }
\ No newline at end of file
@@ -12,6 +12,8 @@ class ConfigParser {
     std::uint32_t m_errorLine;  /* Defines the line number the error has occurred */
     std::string m_errorMessage; /* The error message to print */
     bool parseColor(const std::string &block, COLORREF &color, std::uint32_t line);
+    /// @param unit milliseconds per unit of the configured value
+    bool parseUpdateCycle(const std::string &block, int &milliseconds, std::uint32_t line, int unit = 1);
 
    public:
     ConfigParser();
@@ -1,16 +1,36 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #pragma warning(push, 0)
 #include "EuroScopePlugIn.h"
 #pragma warning(pop)
 
 namespace vacdm {
+constexpr int minReconciliationSeconds = 10;
+constexpr int maxReconciliationSeconds = 600;
+constexpr int minPushConsistencySeconds = 10;
+constexpr int maxPushConsistencySeconds = 600;
+
 struct PluginConfig {
     bool valid = true;
     std::string serverUrl = "https://app.vacdm.net";
-    int updateCycleSeconds = 5;
+    /// @brief base urls of backend mirrors, the requests are hedged to them and fail over if the server does not answer
+    std::vector<std::string> serverMirrors;
+    int updateCycleMilliseconds = 5000;
+    /// @brief adapts the cadence to the activity and the backend latency within the bounds below
+    bool adaptiveUpdateCycle = false;
+    int minUpdateCycleMilliseconds = 1000;
+    int maxUpdateCycleMilliseconds = 10000;
+    /// @brief duration of one sweep over all flightplans, the callbacks deliver the changes in between
+    int reconciliationSeconds = 60;
+    /// @brief subscribes to the pilot changes instead of polling them in every cycle
+    bool pushChannel = false;
+    /// @brief the server-sent events endpoint, derived from the server url if empty, e.g. for a local stand-in server
+    std::string pushUrl = "";
+    /// @brief interval of the consistency polls while the push channel is established
+    int pushConsistencySeconds = 60;
     COLORREF lightgreen = RGB(127, 252, 73);
     COLORREF lightblue = RGB(53, 218, 235);
     COLORREF green = RGB(0, 181, 27);
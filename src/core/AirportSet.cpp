@@ -0,0 +1,49 @@
+#include "AirportSet.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace vacdm::core;
+
+AirportSet::AirportSet(const std::vector<std::string> &airports) : m_codes(), m_names() {
+    for (const auto &airport : airports) {
+        const auto code = AirportSet::pack(airport);
+        if (AirportSet::InvalidIcao != code) this->m_codes.push_back(code);
+    }
+
+    // the packed codes keep the character order, sorting them sorts the names as well
+    std::sort(this->m_codes.begin(), this->m_codes.end());
+    this->m_codes.erase(std::unique(this->m_codes.begin(), this->m_codes.end()), this->m_codes.end());
+
+    for (const auto code : std::as_const(this->m_codes)) {
+        std::string name;
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            const char c = static_cast<char>((code >> shift) & 0xff);
+            if ('\0' != c) name.push_back(c);
+        }
+        this->m_names.push_back(name);
+    }
+}
+
+AirportSet::PackedIcao AirportSet::pack(std::string_view icao) {
+    if (true == icao.empty() || icao.size() > 4) return AirportSet::InvalidIcao;
+
+    PackedIcao code = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        code <<= 8;
+        if (i < icao.size()) code |= static_cast<std::uint8_t>(icao[i]);
+    }
+    return code;
+}
+
+bool AirportSet::contains(PackedIcao icao) const {
+    bool found = false;
+    for (const auto code : this->m_codes) found |= code == icao;
+    return found && AirportSet::InvalidIcao != icao;
+}
+
+bool AirportSet::contains(std::string_view icao) const { return this->contains(AirportSet::pack(icao)); }
+
+bool AirportSet::empty() const { return this->m_codes.empty(); }
+
+const std::list<std::string> &AirportSet::names() const { return this->m_names; }
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vacdm::core {
+/// @brief immutable set of airports, the ICAO codes are stored packed into 32-bit integers
+/// @details The set is small (the active airports of one controller), the membership check scans the packed codes
+/// without branching on the individual entries.
+class AirportSet {
+   public:
+    typedef std::uint32_t PackedIcao;
+    /// @brief the packed value of codes that can not be packed, it is never part of a set
+    static constexpr PackedIcao InvalidIcao = 0;
+
+   private:
+    std::vector<PackedIcao> m_codes;
+    std::list<std::string> m_names;
+
+   public:
+    AirportSet() = default;
+    /// @brief creates the set, duplicates and codes that can not be packed are ignored
+    explicit AirportSet(const std::vector<std::string> &airports);
+
+    /// @brief packs an ICAO code with up to four characters
+    /// @return the packed code or InvalidIcao if the code is empty or too long
+    static PackedIcao pack(std::string_view icao);
+
+    bool contains(PackedIcao icao) const;
+    bool contains(std::string_view icao) const;
+    bool empty() const;
+    /// @brief the ICAO codes of the set, sorted
+    const std::list<std::string> &names() const;
+};
+}  // namespace vacdm::core
@@ -0,0 +1,39 @@
+#include "CallsignRegistry.h"
+
+#include <mutex>
+
+using namespace vacdm::core;
+
+CallsignRegistry::Id CallsignRegistry::intern(std::string_view callsign) {
+    {
+        std::shared_lock guard(this->m_lock);
+        const auto it = this->m_ids.find(callsign);
+        if (this->m_ids.end() != it) return it->second;
+    }
+
+    std::unique_lock guard(this->m_lock);
+    // another thread may have interned the callsign in the meantime
+    const auto it = this->m_ids.find(callsign);
+    if (this->m_ids.end() != it) return it->second;
+
+    const auto id = static_cast<Id>(this->m_callsigns.size());
+    this->m_callsigns.emplace_back(callsign);
+    this->m_ids.emplace(this->m_callsigns.back(), id);
+    return id;
+}
+
+CallsignRegistry::Id CallsignRegistry::find(std::string_view callsign) const {
+    std::shared_lock guard(this->m_lock);
+    const auto it = this->m_ids.find(callsign);
+    return this->m_ids.end() != it ? it->second : CallsignRegistry::InvalidId;
+}
+
+const std::string &CallsignRegistry::callsign(Id id) const {
+    std::shared_lock guard(this->m_lock);
+    return this->m_callsigns[id];
+}
+
+std::size_t CallsignRegistry::size() const {
+    std::shared_lock guard(this->m_lock);
+    return this->m_callsigns.size();
+}
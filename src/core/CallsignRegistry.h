@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace vacdm::core {
+/// @brief interns callsigns to dense integer ids
+/// @details The ids are assigned once per callsign and session and are never reused. They are used as index into the
+/// pilot store, lookups with a std::string_view (e.g. the callsign of a EuroScope flightplan) do not allocate.
+class CallsignRegistry {
+   public:
+    typedef std::uint32_t Id;
+    static constexpr Id InvalidId = std::numeric_limits<Id>::max();
+
+   private:
+    struct Hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const noexcept { return std::hash<std::string_view>{}(value); }
+    };
+
+    mutable std::shared_mutex m_lock;
+    std::unordered_map<std::string, Id, Hash, std::equal_to<>> m_ids;
+    std::deque<std::string> m_callsigns;
+
+   public:
+    CallsignRegistry() = default;
+    CallsignRegistry(const CallsignRegistry &) = delete;
+    CallsignRegistry(CallsignRegistry &&) = delete;
+    CallsignRegistry &operator=(const CallsignRegistry &) = delete;
+    CallsignRegistry &operator=(CallsignRegistry &&) = delete;
+
+    /// @brief returns the id of the callsign, creates a new id if the callsign is unknown
+    Id intern(std::string_view callsign);
+    /// @brief returns the id of the callsign or InvalidId if the callsign is unknown
+    Id find(std::string_view callsign) const;
+    /// @brief returns the callsign of an id, the reference is valid for the lifetime of the registry
+    const std::string &callsign(Id id) const;
+    /// @brief returns the number of interned callsigns, all ids are smaller than this value
+    std::size_t size() const;
+};
+}  // namespace vacdm::core
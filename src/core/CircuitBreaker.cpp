@@ -0,0 +1,117 @@
+#include "CircuitBreaker.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "log/Logger.h"
+
+using namespace vacdm::com;
+using namespace vacdm::logging;
+using namespace std::chrono_literals;
+
+// the circuit opens after these consecutive failures, the backoff doubles with every failed probe up to the maximum
+static constexpr std::uint32_t __failureThreshold = 3;
+static constexpr auto __initialBackoff = 2s;
+static constexpr auto __maximumBackoff = 120s;
+
+CircuitBreaker::CircuitBreaker(std::string name)
+    : m_lock(),
+      m_name(std::move(name)),
+      m_state(State::Closed),
+      m_consecutiveFailures(0),
+      m_openings(0),
+      m_retryAt(),
+      m_rejectedRequests(0),
+      m_random(std::random_device()()) {}
+
+bool CircuitBreaker::allowRequest() {
+    std::lock_guard guard(this->m_lock);
+
+    switch (this->m_state) {
+        case State::Closed:
+            return true;
+        case State::Open:
+            if (std::chrono::steady_clock::now() >= this->m_retryAt) {
+                // the caller sends the probe, all others fail fast until its result is recorded
+                this->m_state = State::HalfOpen;
+                Logger::instance().log(Logger::LogSender::Server, this->m_name + " circuit half-open, probing",
+                                       Logger::LogLevel::Info);
+                return true;
+            }
+            break;
+        case State::HalfOpen:
+        default:
+            break;
+    }
+
+    this->m_rejectedRequests += 1;
+    return false;
+}
+
+void CircuitBreaker::recordSuccess() {
+    std::lock_guard guard(this->m_lock);
+
+    if (State::Closed != this->m_state)
+        Logger::instance().log(Logger::LogSender::Server, this->m_name + " circuit closed", Logger::LogLevel::Info);
+
+    this->m_state = State::Closed;
+    this->m_consecutiveFailures = 0;
+    this->m_openings = 0;
+}
+
+void CircuitBreaker::recordFailure() {
+    std::lock_guard guard(this->m_lock);
+
+    this->m_consecutiveFailures += 1;
+    if (State::HalfOpen == this->m_state || __failureThreshold <= this->m_consecutiveFailures) this->open();
+}
+
+void CircuitBreaker::open() {
+    this->m_openings += 1;
+
+    // exponential backoff, the jitter keeps the clients from probing the recovering backend at the same time
+    const auto exponent = std::min<std::uint32_t>(this->m_openings - 1, 16);
+    const auto backoff = std::min<std::chrono::milliseconds>(__initialBackoff * (1ll << exponent), __maximumBackoff);
+    std::uniform_int_distribution<std::int64_t> jitter(backoff.count() / 2, backoff.count());
+    const auto delay = std::chrono::milliseconds(jitter(this->m_random));
+
+    this->m_state = State::Open;
+    this->m_retryAt = std::chrono::steady_clock::now() + delay;
+
+    Logger::instance().log(Logger::LogSender::Server,
+                           this->m_name + " circuit opened after " + std::to_string(this->m_consecutiveFailures) +
+                               " failures, retry in " + std::to_string(delay.count()) + " ms",
+                           Logger::LogLevel::Warning);
+}
+
+void CircuitBreaker::reset() {
+    std::lock_guard guard(this->m_lock);
+
+    this->m_state = State::Closed;
+    this->m_consecutiveFailures = 0;
+    this->m_openings = 0;
+}
+
+std::string CircuitBreaker::status() {
+    std::lock_guard guard(this->m_lock);
+
+    std::string state;
+    switch (this->m_state) {
+        case State::Closed:
+            state = "closed";
+            break;
+        case State::Open: {
+            const auto remaining = std::chrono::ceil<std::chrono::seconds>(
+                std::max(this->m_retryAt - std::chrono::steady_clock::now(), std::chrono::steady_clock::duration(0)));
+            state = "open, probing in " + std::to_string(remaining.count()) + " s";
+            break;
+        }
+        case State::HalfOpen:
+        default:
+            state = "half-open, probing";
+            break;
+    }
+
+    return this->m_name + ": " + state + " (" + std::to_string(this->m_consecutiveFailures) +
+           " consecutive failures, " + std::to_string(this->m_rejectedRequests) + " requests rejected)";
+}
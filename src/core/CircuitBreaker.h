@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+
+namespace vacdm::com {
+/// @brief guards one backend endpoint against outages
+/// @details After a number of consecutive failures the circuit opens and the requests fail fast. When the backoff has
+/// passed a single probe request is allowed, it closes the circuit on success or reopens it with a doubled backoff.
+class CircuitBreaker {
+   public:
+    enum class State { Closed, Open, HalfOpen };
+
+   private:
+    std::mutex m_lock;
+    std::string m_name;
+    State m_state;
+    std::uint32_t m_consecutiveFailures;
+    /// @brief number of openings since the circuit was closed the last time, defines the backoff
+    std::uint32_t m_openings;
+    std::chrono::steady_clock::time_point m_retryAt;
+    std::uint64_t m_rejectedRequests;
+    std::mt19937 m_random;
+
+    void open();
+
+   public:
+    explicit CircuitBreaker(std::string name);
+    CircuitBreaker(const CircuitBreaker &) = delete;
+    CircuitBreaker(CircuitBreaker &&) = delete;
+    CircuitBreaker &operator=(const CircuitBreaker &) = delete;
+    CircuitBreaker &operator=(CircuitBreaker &&) = delete;
+
+    /// @brief checks if a request may be sent, only one probe passes while the circuit is half-open
+    bool allowRequest();
+    void recordSuccess();
+    void recordFailure();
+    /// @brief closes the circuit without a probe, e.g. if the server address changed
+    void reset();
+    /// @brief returns the state as human readable message
+    std::string status();
+};
+}  // namespace vacdm::com
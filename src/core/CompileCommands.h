@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <chrono>
+#include <optional>
 #include <string>
 
 #pragma warning(push, 0)
@@ -75,20 +77,57 @@ bool vACDM::OnCompileCommand(const char *sCommandLine) {
         return true;
     } else if (std::string::npos != command.find("UPDATERATE")) {
         const auto elements = vacdm::utils::String::splitString(command, " ");
-        if (elements.size() != 3) {
-            DisplayMessage("Usage: .vacdm UPDATERATE value");
+        if (2 == elements.size()) {
+            DisplayMessage(DataManager::instance().updateCycleStatus());
             return true;
         }
-        if (false == isNumber(elements[2]) ||
-            std::stoi(elements[2]) < minUpdateCycleSeconds && std::stoi(elements[2]) > maxUpdateCycleSeconds) {
-            DisplayMessage("Usage: .vacdm UPDATERATE value");
-            DisplayMessage("Value must be number between " + std::to_string(minUpdateCycleSeconds) + " and " +
-                           std::to_string(maxUpdateCycleSeconds));
-            return true;
+
+        // the values are seconds with up to three decimals, e.g. 2.5
+        const auto toMilliseconds = [](const std::string &value) -> std::optional<std::chrono::milliseconds> {
+            const auto separator = value.find('.');
+            const auto seconds = value.substr(0, separator);
+            auto fraction = std::string::npos != separator ? value.substr(separator + 1) : std::string();
+            if (false == isNumber(seconds) || seconds.length() > 3 || fraction.length() > 3 ||
+                (false == fraction.empty() && false == isNumber(fraction)))
+                return std::nullopt;
+
+            fraction.resize(3, '0');
+            const auto milliseconds = std::stoi(seconds) * 1000 + std::stoi(fraction);
+            if (milliseconds < minUpdateCycleMilliseconds || milliseconds > maxUpdateCycleMilliseconds)
+                return std::nullopt;
+            return std::chrono::milliseconds(milliseconds);
+        };
+
+        std::optional<std::chrono::milliseconds> minimum, maximum;
+        if ("AUTO" == elements[2] && 3 == elements.size()) {
+            minimum = std::chrono::milliseconds(this->m_pluginConfig.minUpdateCycleMilliseconds);
+            maximum = std::chrono::milliseconds(this->m_pluginConfig.maxUpdateCycleMilliseconds);
+        } else if ("AUTO" == elements[2] && 5 == elements.size()) {
+            minimum = toMilliseconds(elements[3]);
+            maximum = toMilliseconds(elements[4]);
+        } else if (3 == elements.size()) {
+            minimum = maximum = toMilliseconds(elements[2]);
         }
 
-        DisplayMessage(DataManager::instance().setUpdateCycleSeconds(std::stoi(elements[2])));
+        if (false == minimum.has_value() || false == maximum.has_value() || minimum.value() > maximum.value()) {
+            DisplayMessage("Usage: .vacdm UPDATERATE [seconds | AUTO [minimum maximum]]");
+            DisplayMessage("Values are seconds with up to three decimals, between " +
+                           std::to_string(minUpdateCycleMilliseconds) + " and " +
+                           std::to_string(maxUpdateCycleMilliseconds) + " milliseconds");
+        } else if ("AUTO" == elements[2]) {
+            DisplayMessage(DataManager::instance().setAdaptiveUpdateCycle(minimum.value(), maximum.value()));
+        } else {
+            DisplayMessage(DataManager::instance().setUpdateCycle(minimum.value()));
+        }
 
+        return true;
+    } else if (std::string::npos != command.find("BACKEND")) {
+        for (const auto &message : com::Server::instance().breakerStatus()) DisplayMessage(message);
+        for (const auto &message : com::Server::instance().mirrorStatus()) DisplayMessage(message);
+        for (const auto &message : com::Server::instance().transferStatus()) DisplayMessage(message);
+        return true;
+    } else if (std::string::npos != command.find("STATS")) {
+        for (const auto &message : DataManager::instance().statistics()) DisplayMessage(message);
         return true;
     }
     return false;
@@ -1,19 +1,101 @@
 #include "DataManager.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+#include "core/PilotSnapshot.h"
 #include "core/Server.h"
 #include "log/Logger.h"
+#include "types/PilotJson.h"
 #include "utils/Date.h"
+#include "utils/String.h"
 
 using namespace vacdm::com;
 using namespace vacdm::core;
 using namespace vacdm::logging;
 using namespace std::chrono_literals;
 
-static constexpr std::size_t ConsolidatedData = 0;
-static constexpr std::size_t EuroscopeData = 1;
-static constexpr std::size_t ServerData = 2;
+// limits of the per pilot and update cycle messages, these would otherwise log every pilot in every cycle
+static const Logger::LogLimit __perPilotLogLimit{60s, 1};
+static const Logger::LogLimit __updateQueueLogLimit{0s, 10};
+static const Logger::LogLimit __statisticsLogLimit{60s, 1};
+
+// the partitions are processed in parallel, a few threads are sufficient even for large sectors
+static constexpr std::size_t __maximumWorkerThreads = 4;
+
+// the worker thread checks the schedule at this resolution, it bounds the accuracy of the cadence
+static constexpr auto __schedulerResolution = 50ms;
+
+// the adaptive cadence polls at the minimum while controllers interact or departures are imminent
+static constexpr auto __interactionWindow = 30s;
+static constexpr auto __imminentWindow = 5min;
+// the adaptive cadence slows down gradually, by this factor per cycle
+static constexpr double __backoffFactor = 1.5;
+
+// hot pilots are refreshed in every cycle, warm pilots in every third and cold pilots in every twelfth cycle
+static constexpr std::size_t __warmRefreshCycles = 3;
+static constexpr std::size_t __coldRefreshCycles = 12;
+// pilots are hot until their TSAT or TOBT is this far away, or overdue less than the overdue window
+static constexpr auto __hotWindow = 30min;
+static constexpr auto __overdueWindow = 10min;
+// beyond the warm window the pilots are cold
+static constexpr auto __warmWindow = 2h;
+
+// a write which the backend data does not reflect within this many cycles is sent again
+static constexpr std::size_t __writeEchoCycles = 12;
+
+// the snapshot is written once per interval, older snapshots are not restored
+static constexpr auto __snapshotInterval = 60s;
+static constexpr auto __snapshotMaximumAge = 15min;
+
+// position changes below the deadband (in degrees, roughly 10 m) do not trigger a new EuroScope update
+static constexpr double __positionDeadband = 0.0001;
+
+// FNV-1a, only used to detect changes of the extracted flightplan fields
+static std::uint64_t __fingerprint(std::uint64_t hash, std::string_view value) {
+    for (const auto c : value) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 0x100000001b3ull;
+    }
+    // separate the fields, otherwise "AB" + "C" equals "A" + "BC"
+    hash ^= 0xff;
+    return hash * 0x100000001b3ull;
+}
+
+static std::uint64_t __fingerprint(std::uint64_t hash, double value) {
+    const auto rounded = std::llround(value / __positionDeadband);
+    return __fingerprint(hash, std::string_view(reinterpret_cast<const char*>(&rounded), sizeof(rounded)));
+}
+
+// formats a duration in seconds with millisecond resolution, e.g. "2.5"
+static std::string __seconds(const std::chrono::milliseconds& duration) {
+    auto seconds = std::to_string(duration.count() / 1000);
+    if (0 != duration.count() % 1000) {
+        auto fraction = std::to_string(1000 + duration.count() % 1000).substr(1);
+        while ('0' == fraction.back()) fraction.pop_back();
+        seconds += "." + fraction;
+    }
+    return seconds;
+}
+
+static std::int64_t __steadyMilliseconds() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
 
-DataManager::DataManager() : m_pause(false), m_stop(false) { this->m_worker = std::thread(&DataManager::run, this); }
+DataManager::DataManager()
+    : m_pause(false),
+      m_stop(false),
+      m_lastInteraction(std::numeric_limits<std::int64_t>::min()),
+      m_pushConsistencyMilliseconds(60000),
+      m_workerPool(std::clamp<std::size_t>(std::thread::hardware_concurrency() / 2, 1, __maximumWorkerThreads)),
+      m_writer(1) {
+    this->setActiveAirports(AirportSet());
+    this->m_worker = std::thread(&DataManager::run, this);
+}
 
 DataManager::~DataManager() {
     this->m_stop = true;
@@ -25,184 +107,664 @@ DataManager& DataManager::instance() {
     return __instance;
 }
 
-bool DataManager::checkPilotExists(const std::string& callsign) {
+bool DataManager::checkPilotExists(std::string_view callsign) {
     if (true == this->m_pause) return false;
 
-    std::lock_guard guard(this->m_pilotLock);
-    return this->m_pilots.cend() != this->m_pilots.find(callsign);
+    const auto id = this->m_callsigns.find(callsign);
+    if (CallsignRegistry::InvalidId == id) return false;
+
+    std::shared_lock partitionGuard(this->m_partitionLock);
+    Slot slot;
+    const auto partition = this->locatePilot(id, slot);
+    if (nullptr == partition) return false;
+
+    std::lock_guard guard(partition->lock);
+    const auto& pilots = *partition->published;
+    return slot < pilots.size() && true == pilots[slot].has_value();
 }
 
-const types::Pilot DataManager::getPilot(const std::string& callsign) {
-    std::lock_guard guard(this->m_pilotLock);
-    return this->m_pilots.find(callsign)->second[ConsolidatedData];
+std::optional<types::Pilot> DataManager::getPilot(std::string_view callsign) {
+    if (true == this->m_pause) return std::nullopt;
+
+    const auto id = this->m_callsigns.find(callsign);
+    if (CallsignRegistry::InvalidId == id) return std::nullopt;
+
+    std::shared_lock partitionGuard(this->m_partitionLock);
+    Slot slot;
+    const auto partition = this->locatePilot(id, slot);
+    if (nullptr == partition) return std::nullopt;
+
+    std::lock_guard guard(partition->lock);
+    const auto& pilots = *partition->published;
+    if (slot >= pilots.size() || false == pilots[slot].has_value()) return std::nullopt;
+    return pilots[slot].value().materialize();
+}
+
+bool DataManager::readPilot(std::string_view callsign, types::Pilot& pilot) {
+    if (true == this->m_pause) return false;
+
+    const auto id = this->m_callsigns.find(callsign);
+    if (CallsignRegistry::InvalidId == id) return false;
+
+    std::shared_lock partitionGuard(this->m_partitionLock);
+    Slot slot;
+    const auto partition = this->locatePilot(id, slot);
+    if (nullptr == partition) return false;
+
+    std::lock_guard guard(partition->lock);
+    const auto& pilots = *partition->published;
+    if (slot >= pilots.size() || false == pilots[slot].has_value()) return false;
+    pilots[slot].value().materialize(pilot);
+    return true;
+}
+
+DataManager::Partition* DataManager::locatePilot(CallsignRegistry::Id id, Slot& slot) const {
+    if (id >= this->m_locations.size()) return nullptr;
+
+    const auto& location = this->m_locations[id];
+    if (InvalidPartition == location.partition) return nullptr;
+
+    slot = location.slot;
+    return this->m_partitions[location.partition].get();
+}
+
+DataManager::Slot DataManager::allocateSlot(Partition& partition) {
+    partition.addedPilots = true;
+    if (true == partition.freeSlots.empty()) return partition.slots++;
+
+    const auto slot = partition.freeSlots.back();
+    partition.freeSlots.pop_back();
+    if (slot < partition.pendingWrites.size()) partition.pendingWrites[slot] = PendingWrite();
+    return slot;
+}
+
+void DataManager::releaseSlots() {
+    for (std::size_t index = 0; index < this->m_partitions.size(); ++index) {
+        auto& partition = *this->m_partitions[index];
+        auto& released = partition.releasedSlots;
+        if (true == released.empty()) continue;
+
+        // a slot may be released more than once, e.g. by a reset and the inactive flag of the backend
+        std::sort(released.begin(), released.end(),
+                  [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+        released.erase(std::unique(released.begin(), released.end(),
+                                   [](const auto& lhs, const auto& rhs) { return lhs.second == rhs.second; }),
+                       released.end());
+
+        std::unique_lock partitionGuard(this->m_partitionLock);
+        std::lock_guard guard(partition.lock);
+        std::erase_if(released, [this, index, &partition](const auto& entry) {
+            const auto [id, slot] = entry;
+            const auto occupied = [slot](const PilotTable& pilots) {
+                return slot < pilots.size() && true == pilots[slot].has_value();
+            };
+
+            // the pilot has been added again in the meantime
+            if (true == occupied(*partition.published)) return true;
+            // the back buffer or pending edits of the tag functions still refer to the pilot, retry in the next cycle
+            if (true == occupied(*partition.next) ||
+                std::any_of(partition.localEdits.cbegin(), partition.localEdits.cend(),
+                            [slot](const LocalEdit& edit) { return slot == edit.slot; }))
+                return false;
+
+            // removed pilots lose their location, moved pilots have a new one already
+            if (id < this->m_locations.size() && index == this->m_locations[id].partition &&
+                slot == this->m_locations[id].slot)
+                this->m_locations[id] = PilotLocation();
+            partition.freeSlots.push_back(slot);
+            return true;
+        });
+    }
+}
+
+std::uint32_t DataManager::partitionOf(const std::string& airport) {
+    const auto key = AirportSet::pack(airport);
+    for (std::size_t i = 0; i < this->m_partitions.size(); ++i) {
+        if (key == this->m_partitions[i]->key) return static_cast<std::uint32_t>(i);
+    }
+
+    auto partition = std::make_unique<Partition>();
+    partition->key = key;
+    partition->airport = airport;
+
+    std::unique_lock guard(this->m_partitionLock);
+    this->m_partitions.push_back(std::move(partition));
+    return static_cast<std::uint32_t>(this->m_partitions.size() - 1);
 }
 
 void DataManager::pause() { this->m_pause = true; }
 
 void DataManager::resume() { this->m_pause = false; }
 
-std::string DataManager::setUpdateCycleSeconds(const int newUpdateCycleSeconds) {
-    if (newUpdateCycleSeconds < minUpdateCycleSeconds || newUpdateCycleSeconds > maxUpdateCycleSeconds)
+std::string DataManager::setUpdateCycle(std::chrono::milliseconds cycle) {
+    if (cycle.count() < minUpdateCycleMilliseconds || cycle.count() > maxUpdateCycleMilliseconds)
         return "Could not set update rate";
 
-    this->updateCycleSeconds = newUpdateCycleSeconds;
+    std::lock_guard guard(this->m_updateCycleLock);
+    this->m_updateCycle.adaptive = false;
+    this->m_updateCycle.fixed = cycle;
+    this->m_updateCycle.current = cycle;
 
-    return "vACDM updating every " +
-           (newUpdateCycleSeconds == 1 ? "second" : std::to_string(newUpdateCycleSeconds) + " seconds");
+    return "vACDM updating every " + (1000 == cycle.count() ? "second" : __seconds(cycle) + " seconds");
 }
 
-void DataManager::run() {
-    std::size_t counter = 1;
-    while (true) {
-        std::this_thread::sleep_for(1s);
-        if (true == this->m_stop) return;
-        if (true == this->m_pause) continue;
+std::string DataManager::setAdaptiveUpdateCycle(std::chrono::milliseconds minimum, std::chrono::milliseconds maximum) {
+    if (minimum.count() < minUpdateCycleMilliseconds || maximum.count() > maxUpdateCycleMilliseconds ||
+        minimum > maximum)
+        return "Could not set update rate";
 
-        // run every updateCycleSeconds seconds
-        if (counter++ % updateCycleSeconds != 0) continue;
+    {
+        std::lock_guard guard(this->m_updateCycleLock);
+        this->m_updateCycle.adaptive = true;
+        this->m_updateCycle.minimum = minimum;
+        this->m_updateCycle.maximum = maximum;
+        this->m_updateCycle.current = std::clamp(this->m_updateCycle.current, minimum, maximum);
+    }
 
-        // obtain a copy of the pilot data, work with the copy to minimize lock time
-        this->m_pilotLock.lock();
-        auto pilots = this->m_pilots;
-        this->m_pilotLock.unlock();
+    return this->updateCycleStatus();
+}
 
-        this->processAsynchronousMessages(pilots);
+std::string DataManager::updateCycleStatus() {
+    std::lock_guard guard(this->m_updateCycleLock);
 
-        this->processEuroScopeUpdates(pilots);
+    const auto& cycle = this->m_updateCycle;
+    auto status = "vACDM updating every " + __seconds(cycle.current) + " seconds";
+    if (true == cycle.adaptive)
+        status += " (adaptive, " + __seconds(cycle.minimum) + " to " + __seconds(cycle.maximum) + " seconds)";
+    else
+        status += " (fixed)";
+    return status;
+}
 
-        this->consolidateWithBackend(pilots);
+std::chrono::milliseconds DataManager::currentUpdateCycle() {
+    std::lock_guard guard(this->m_updateCycleLock);
+    return this->m_updateCycle.current;
+}
+
+std::chrono::milliseconds DataManager::adaptUpdateCycle(const CycleMetrics& metrics, std::size_t pilots,
+                                                        std::size_t imminentPilots) {
+    std::lock_guard guard(this->m_updateCycleLock);
+
+    auto& cycle = this->m_updateCycle;
+    if (false == cycle.adaptive) return cycle.current;
+
+    const auto lastInteraction = this->m_lastInteraction.load();
+    const auto interacting =
+        std::numeric_limits<std::int64_t>::min() != lastInteraction &&
+        __steadyMilliseconds() - lastInteraction <
+            std::chrono::duration_cast<std::chrono::milliseconds>(__interactionWindow).count();
+
+    std::chrono::milliseconds target;
+    if (true == interacting || 0 != imminentPilots)
+        target = cycle.minimum;
+    else if (0 == pilots)
+        target = cycle.maximum;
+    else
+        target = (cycle.minimum + cycle.maximum) / 2;
+
+    // polling faster than the backend answers only queues the requests
+    target = std::max(target, std::chrono::ceil<std::chrono::milliseconds>(2 * metrics.fetch));
+    target = std::clamp(target, cycle.minimum, cycle.maximum);
+
+    // speed up immediately, slow down gradually
+    if (target > cycle.current) {
+        const auto step = std::chrono::milliseconds(static_cast<std::int64_t>(cycle.current.count() * __backoffFactor));
+        target = std::min(target, std::max(step, cycle.current + std::chrono::milliseconds(1)));
+    }
+    cycle.current = target;
+
+    return cycle.current;
+}
+
+void DataManager::run() {
+    auto lastCycle = std::chrono::steady_clock::now();
+    while (true) {
+        std::this_thread::sleep_for(__schedulerResolution);
+        if (true == this->m_stop) {
+            // keep the latest data for a restart of EuroScope
+            this->saveSnapshot();
+            return;
+        }
+        this->retireAirportSets();
+        this->restoreSnapshot();
+        if (true == this->m_pause) {
+            // the server may be changed while the DataManager is paused, drop the prefetched and pushed data
+            this->m_backendFetch = {};
+            this->m_push.takePilots();
+            continue;
+        }
 
-        if (true == Server::instance().getMaster()) {
-            std::list<std::tuple<types::Pilot, DataManager::MessageType, Json::Value>> transmissionBuffer;
-            for (auto& pilot : pilots) {
-                Json::Value message;
-                const auto sendType = DataManager::deltaEuroscopeToBackend(pilot.second, message);
-                if (MessageType::None != sendType)
-                    transmissionBuffer.push_back({pilot.second[ConsolidatedData], sendType, message});
+        // the pushed changes are visible as they arrive, not only after the next cycle
+        this->mergePushedPilots();
+
+        // the cadence is read in every check, a changed update rate is effective immediately
+        if (std::chrono::steady_clock::now() - lastCycle < this->currentUpdateCycle()) continue;
+
+        CycleMetrics metrics;
+        const auto cycleStart = std::chrono::steady_clock::now();
+        lastCycle = cycleStart;
+        this->m_cycle += 1;
+        auto stageStart = cycleStart;
+        const auto finishStage = [&stageStart]() {
+            const auto now = std::chrono::steady_clock::now();
+            const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - stageStart);
+            stageStart = now;
+            return duration;
+        };
+
+        // build the next generation in the back buffers, the UI thread keeps reading the published ones
+        for (auto& partition : this->m_partitions) DataManager::synchronizeBackBuffer(*partition);
+        metrics.synchronize = finishStage();
+
+        // the writes are queued and drained by the writer thread while the cycle continues, the writes of an outage
+        // are replayed first
+        if (0 != Server::instance().pendingWrites() && 0 == this->m_writer.pending())
+            this->queueWrite([]() { Server::instance().flushOutbox(); });
+        this->processAsynchronousMessages();
+        metrics.messages = finishStage();
+
+        // the backend data of this cycle has been requested in the previous cycle, the data of the next cycle is
+        // requested behind the writes queued until now while this cycle is merged
+        auto backendFetch = std::move(this->m_backendFetch);
+        if (false == backendFetch.valid()) backendFetch = this->fetchBackendData(this->m_cycle);
+        this->m_backendFetch = this->fetchBackendData(this->m_cycle + 1);
+        auto backendData = backendFetch.get();
+        this->m_backendWriteSequence = backendData.writeSequence;
+        metrics.fetch = backendData.duration;
+        metrics.fetchWait = finishStage();
+
+        // the routing is serial, it may create partitions and move pilots between them
+        this->releaseSlots();
+        this->routeEuroScopeUpdates();
+        this->routeBackendUpdates(std::move(backendData.pilots));
+        metrics.routing = finishStage();
+
+        const auto master = Server::instance().getMaster();
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve(this->m_partitions.size());
+        for (auto& partition : this->m_partitions) {
+            tasks.push_back([this, &current = *partition, master, cycle = this->m_cycle]() {
+                this->processPartition(current, master, cycle);
+            });
+        }
+        this->m_workerPool.run(std::move(tasks));
+        metrics.partitions = finishStage();
+
+        std::size_t pilots = 0, imminentPilots = 0;
+        for (auto& partition : this->m_partitions) {
+            {
+                std::lock_guard guard(partition->lock);
+                pilots += partition->metrics.pilots;
+                imminentPilots += partition->metrics.imminentPilots;
             }
 
-            for (const auto& transmission : std::as_const(transmissionBuffer)) {
-                if (std::get<1>(transmission) == MessageType::Post)
-                    com::Server::instance().postPilot(std::get<0>(transmission));
-                else if (std::get<1>(transmission) == MessageType::Patch)
-                    com::Server::instance().sendPatchMessage("/api/v1/pilots/" + std::get<0>(transmission).callsign,
-                                                             std::get<2>(transmission));
+            for (auto& transmission : partition->transmissions) {
+                this->markPendingWrite(*partition, transmission.slot);
+                if (transmission.type == MessageType::Post) {
+                    this->queueWrite(
+                        [pilot = std::move(transmission.pilot)]() { Server::instance().postPilot(pilot); });
+                } else if (transmission.type == MessageType::Patch) {
+                    this->queueWrite([endpoint = "/api/v1/pilots/" + transmission.pilot.callsign,
+                                      message = std::move(transmission.message)]() {
+                        Server::instance().sendPatchMessage(endpoint, message);
+                    });
+                }
             }
+            partition->transmissions.clear();
         }
+        metrics.transmissions = finishStage();
+        metrics.total = std::chrono::duration_cast<std::chrono::microseconds>(stageStart - cycleStart);
+
+        {
+            std::lock_guard guard(this->m_metricsLock);
+            this->m_cycleMetrics = metrics;
+        }
+        this->adaptUpdateCycle(metrics, pilots, imminentPilots);
+
+        if (std::chrono::steady_clock::now() - this->m_lastSnapshot >= __snapshotInterval) this->saveSnapshot();
 
-        // replace the pilot data with the updated copy
-        this->m_pilotLock.lock();
-        this->m_pilots = pilots;
-        this->m_pilotLock.unlock();
+        Logger::instance().logLimited(Logger::LogSender::DataManager, "statistics", __statisticsLogLimit,
+                                      utils::String::join(this->statistics(), " | "), Logger::LogLevel::Info,
+                                      {"", "", "Statistics"});
     }
 }
 
-void DataManager::processAsynchronousMessages(std::map<std::string, std::array<types::Pilot, 3U>>& pilots) {
+void DataManager::processPartition(Partition& partition, bool master, std::size_t cycle) {
+    const auto start = std::chrono::steady_clock::now();
+
+    PartitionMetrics metrics;
+    metrics.euroscopeUpdates = partition.euroscopeUpdates.size();
+    metrics.backendUpdates = partition.backendUpdates.size();
+
+    // pilots changed by EuroScope are checked for changes independent of their tier
+    std::vector<bool> euroscopeChanges(partition.slots, false);
+    for (const auto& update : std::as_const(partition.euroscopeUpdates)) euroscopeChanges[update.slot] = true;
+
+    this->processEuroScopeUpdates(partition);
+    this->consolidateWithBackend(partition);
+
+    const auto now = std::chrono::utc_clock::now();
+    const auto& pilots = *partition.next;
+    partition.tiers.resize(pilots.size(), RefreshTier::Hot);
+    partition.addedPilots = false;
+    for (std::size_t slot = 0; slot < pilots.size(); ++slot) {
+        const auto& pilot = pilots[slot];
+        if (false == pilot.has_value()) continue;
+        metrics.pilots += 1;
+
+        const auto tier = DataManager::classify(pilot.value(), now);
+        partition.tiers[slot] = tier;
+        switch (tier) {
+            case RefreshTier::Hot:
+                metrics.hotPilots += 1;
+                break;
+            case RefreshTier::Warm:
+                metrics.warmPilots += 1;
+                break;
+            case RefreshTier::Cold:
+                metrics.coldPilots += 1;
+                break;
+        }
+
+        const auto& acdm = pilot.value().acdm;
+        const auto departure = types::defaultTime != acdm.tsat.get() ? acdm.tsat.get() : acdm.tobt.get();
+        if (types::defaultTime != departure && types::defaultTime == acdm.aobt.get() &&
+            departure > now - __imminentWindow && departure < now + __imminentWindow)
+            metrics.imminentPilots += 1;
+
+        if (false == DataManager::refreshDue(tier, cycle) && false == euroscopeChanges[slot]) continue;
+        metrics.refreshedPilots += 1;
+
+        if (false == master) continue;
+
+        // the backend data does not contain the last write of the pilot yet, the delta would repeat it
+        if (slot < partition.pendingWrites.size() && 0 != partition.pendingWrites[slot].sequence &&
+            cycle - partition.pendingWrites[slot].cycle < __writeEchoCycles)
+            continue;
+
+        Json::Value message;
+        const auto sendType = DataManager::deltaEuroscopeToBackend(pilot.value(), message);
+        if (MessageType::None != sendType)
+            partition.transmissions.push_back(
+                {pilot.value().materialize(), sendType, std::move(message), static_cast<Slot>(slot)});
+    }
+
+    metrics.transmissions = partition.transmissions.size();
+    metrics.processingTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    DataManager::publishBackBuffer(partition, metrics);
+}
+
+DataManager::RefreshTier DataManager::classify(const types::PilotRecord& pilot,
+                                               const std::chrono::utc_clock::time_point& now) {
+    // pilots unknown to the backend need to be posted
+    if (false == pilot.hasServerData) return RefreshTier::Hot;
+
+    const auto& acdm = pilot.acdm;
+    // airborne pilots only wait for the backend to flag them as inactive
+    if (types::defaultTime != acdm.atot.get()) return RefreshTier::Cold;
+    // startup requested, approved or off-block, the controllers work with the pilot
+    if (types::defaultTime != acdm.asrt.get() || types::defaultTime != acdm.asat.get() ||
+        types::defaultTime != acdm.aobt.get() || types::defaultTime != acdm.aort.get())
+        return RefreshTier::Hot;
+
+    const auto departure = types::defaultTime != acdm.tsat.get() ? acdm.tsat.get() : acdm.tobt.get();
+    if (types::defaultTime == departure) return RefreshTier::Warm;
+    if (departure < now - __overdueWindow) return RefreshTier::Warm;
+    if (departure < now + __hotWindow) return RefreshTier::Hot;
+    if (departure < now + __warmWindow) return RefreshTier::Warm;
+    return RefreshTier::Cold;
+}
+
+bool DataManager::refreshDue(RefreshTier tier, std::size_t cycle) {
+    switch (tier) {
+        case RefreshTier::Warm:
+            return 0 == cycle % __warmRefreshCycles;
+        case RefreshTier::Cold:
+            return 0 == cycle % __coldRefreshCycles;
+        default:
+            return true;
+    }
+}
+
+void DataManager::synchronizeBackBuffer(Partition& partition) {
+    std::lock_guard guard(partition.lock);
+
+    // the back buffer is the previous generation, only the pilots changed since then need to be copied
+    const auto& published = *partition.published;
+    auto& next = *partition.next;
+    if (next.size() < published.size()) next.resize(published.size());
+    for (const auto slot : std::as_const(partition.changedPilots)) next[slot] = published[slot];
+    partition.changedPilots.clear();
+
+    // all edits until now are part of the copied data, only the edits during the cycle need to be replayed
+    partition.localEdits.clear();
+}
+
+void DataManager::publishBackBuffer(Partition& partition, const PartitionMetrics& metrics) {
+    std::lock_guard guard(partition.lock);
+
+    // the tag functions edited the published generation during the cycle, replay the edits on the new one
+    for (const auto& edit : std::as_const(partition.localEdits)) DataManager::applyLocalEdit(*partition.next, edit);
+    partition.localEdits.clear();
+
+    partition.changedPilots.insert(partition.changedPilots.end(), partition.generationChanges.cbegin(),
+                                   partition.generationChanges.cend());
+    partition.generationChanges.clear();
+
+    std::swap(partition.published, partition.next);
+    partition.metrics = metrics;
+}
+
+void DataManager::processAsynchronousMessages() {
     this->m_asyncMessagesLock.lock();
     auto messages = this->m_asynchronousMessages;
     this->m_asynchronousMessages.clear();
     this->m_asyncMessagesLock.unlock();
 
     for (auto& message : messages) {
-        // find pilot in list
-        for (auto& [callsign, data] : pilots) {
-            if (callsign == message.callsign) {
-                std::string messageType;
-
-                switch (message.type) {
-                    case MessageType::UpdateEXOT:
-                        Server::instance().updateExot(message.callsign, message.value);
-                        messageType = "EXOT";
-                        break;
-                    case MessageType::UpdateTOBT:
-                        Server::instance().updateTobt(data[ConsolidatedData], message.value, false);
-                        messageType = "TOBT";
-                        break;
-                    case MessageType::UpdateTOBTConfirmed:
-                        Server::instance().updateTobt(data[ConsolidatedData], message.value, true);
-                        messageType = "TOBT Confirmed Status";
-                        break;
-                    case MessageType::UpdateASAT:
-                        Server::instance().updateAsat(message.callsign, message.value);
-                        messageType = "ASAT";
-                        break;
-                    case MessageType::UpdateASRT:
-                        Server::instance().updateAsrt(message.callsign, message.value);
-                        messageType = "ASRT";
-                        break;
-                    case MessageType::UpdateAOBT:
-                        Server::instance().updateAobt(message.callsign, message.value);
-                        messageType = "AOBT";
-                        break;
-                    case MessageType::UpdateAORT:
-                        Server::instance().updateAort(message.callsign, message.value);
-                        messageType = "AORT";
-                        break;
-                    case MessageType::ResetTOBT:
-                        Server::instance().resetTobt(message.callsign, types::defaultTime,
-                                                     data[ConsolidatedData].tobt_state);
-                        messageType = "TOBT reset";
-                        break;
-                    case MessageType::ResetASAT:
-                        Server::instance().updateAsat(message.callsign, message.value);
-                        messageType = "ASAT reset";
-                        break;
-                    case MessageType::ResetASRT:
-                        Server::instance().updateAsrt(message.callsign, message.value);
-                        messageType = "ASRT reset";
-                        break;
-                    case MessageType::ResetTOBTConfirmed:
-                        Server::instance().resetTobt(message.callsign, data[ConsolidatedData].tobt, "GUESS");
-                        messageType = "TOBT confirmed reset";
-                        break;
-                    case MessageType::ResetAORT:
-                        Server::instance().updateAort(message.callsign, message.value);
-                        messageType = "AORT reset";
-                        break;
-                    case MessageType::ResetAOBT:
-                        Server::instance().updateAobt(message.callsign, message.value);
-                        messageType = "AOBT reset";
-                        break;
-                    case MessageType::ResetPilot:
-                        Server::instance().deletePilot(message.callsign);
-                        messageType = "Pilot reset";
-                        break;
-
-                    default:
-                        break;
-                }
+        const auto& callsign = message.callsign;
+        const auto value = message.value;
+
+        // the pilot is already removed locally, only the backend needs to be informed
+        if (MessageType::ResetPilot == message.type) {
+            Slot slot;
+            const auto partition = this->locatePilot(message.id, slot);
+            if (nullptr != partition) partition->releasedSlots.emplace_back(message.id, slot);
+
+            this->queueWrite([callsign]() { Server::instance().deletePilot(callsign); });
+            Logger::instance().log(Logger::LogSender::DataManager, "Sending Pilot reset update: " + callsign,
+                                   Logger::LogLevel::Info, {callsign, "", "Send"});
+            continue;
+        }
 
-                Logger::instance().log(Logger::LogSender::DataManager,
-                                       "Sending " + messageType + " update: " + callsign + " - " +
-                                           utils::Date::timestampToIsoString(message.value),
-                                       Logger::LogLevel::Info);
+        // skip messages of pilots which have been removed in the meantime
+        Slot slot;
+        const auto partition = this->locatePilot(message.id, slot);
+        if (nullptr == partition) continue;
+        const auto& pilots = *partition->next;
+        if (slot >= pilots.size() || false == pilots[slot].has_value()) continue;
 
+        const auto& data = pilots[slot].value();
+        std::string messageType;
+
+        switch (message.type) {
+            case MessageType::UpdateEXOT:
+                this->queueWrite([callsign, value]() { Server::instance().updateExot(callsign, value); });
+                messageType = "EXOT";
+                break;
+            case MessageType::UpdateTOBT:
+                this->queueWrite([pilot = data.materialize(), value]() {
+                    Server::instance().updateTobt(pilot, value, false);
+                });
+                messageType = "TOBT";
+                break;
+            case MessageType::UpdateTOBTConfirmed:
+                this->queueWrite([pilot = data.materialize(), value]() {
+                    Server::instance().updateTobt(pilot, value, true);
+                });
+                messageType = "TOBT Confirmed Status";
+                break;
+            case MessageType::UpdateASAT:
+            case MessageType::ResetASAT:
+                this->queueWrite([callsign, value]() { Server::instance().updateAsat(callsign, value); });
+                messageType = MessageType::UpdateASAT == message.type ? "ASAT" : "ASAT reset";
+                break;
+            case MessageType::UpdateASRT:
+            case MessageType::ResetASRT:
+                this->queueWrite([callsign, value]() { Server::instance().updateAsrt(callsign, value); });
+                messageType = MessageType::UpdateASRT == message.type ? "ASRT" : "ASRT reset";
+                break;
+            case MessageType::UpdateAOBT:
+            case MessageType::ResetAOBT:
+                this->queueWrite([callsign, value]() { Server::instance().updateAobt(callsign, value); });
+                messageType = MessageType::UpdateAOBT == message.type ? "AOBT" : "AOBT reset";
+                break;
+            case MessageType::UpdateAORT:
+            case MessageType::ResetAORT:
+                this->queueWrite([callsign, value]() { Server::instance().updateAort(callsign, value); });
+                messageType = MessageType::UpdateAORT == message.type ? "AORT" : "AORT reset";
+                break;
+            case MessageType::ResetTOBT:
+                this->queueWrite([callsign, tobtState = data.acdm.tobtState.str()]() {
+                    Server::instance().resetTobt(callsign, types::defaultTime, tobtState);
+                });
+                messageType = "TOBT reset";
+                break;
+            case MessageType::ResetTOBTConfirmed:
+                this->queueWrite([callsign, tobt = data.acdm.tobt.get()]() {
+                    Server::instance().resetTobt(callsign, tobt, "GUESS");
+                });
+                messageType = "TOBT confirmed reset";
+                break;
+            default:
                 break;
-            }
         }
+        if (true == messageType.empty()) continue;
+        this->markPendingWrite(*partition, slot);
+
+        Logger::instance().log(Logger::LogSender::DataManager,
+                               "Sending " + messageType + " update: " + callsign + " - " +
+                                   utils::Date::timestampToIsoString(message.value),
+                               Logger::LogLevel::Info, {callsign, data.euroscope.origin.str(), "Send"});
+    }
+}
+
+void DataManager::markPendingWrite(Partition& partition, Slot slot) {
+    this->m_writeSequence += 1;
+    if (slot >= partition.pendingWrites.size()) partition.pendingWrites.resize(slot + 1);
+    partition.pendingWrites[slot] = {this->m_writeSequence, this->m_cycle};
+}
+
+void DataManager::queueWrite(std::function<void()> write) {
+    this->m_writer.post([this, write = std::move(write)]() {
+        const auto start = std::chrono::steady_clock::now();
+        write();
+        const auto duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        std::lock_guard guard(this->m_metricsLock);
+        this->m_writeMetrics.writes += 1;
+        this->m_writeMetrics.duration += duration;
+    });
+}
+
+std::future<DataManager::BackendData> DataManager::fetchBackendData(std::size_t cycle) {
+    // while the push channel delivers the changes the polling only checks the consistency, a new session may have
+    // missed changes and is checked immediately
+    const auto now = std::chrono::steady_clock::now();
+    const auto session = this->m_push.sessions();
+    if (true == this->m_push.connected() && session == this->m_pushSession &&
+        now - this->m_lastBackendFetch < std::chrono::milliseconds(this->m_pushConsistencyMilliseconds.load()))
+        return std::async(std::launch::deferred, []() { return BackendData(); });
+
+    // the request uses the active airports at the time it is started
+    const auto activeAirports = this->m_activeAirports.load(std::memory_order_acquire);
+
+    // only the airports with pilots that are due in the cycle are requested
+    std::list<std::string> airports;
+    for (const auto& airport : activeAirports->names()) {
+        if (true == this->fetchDue(airport, cycle)) airports.push_back(airport);
     }
+    // an empty list requests the pilots of all airports, skip the request instead
+    if (true == airports.empty() && false == activeAirports->empty())
+        return std::async(std::launch::deferred, []() { return BackendData(); });
+
+    this->m_lastBackendFetch = now;
+    this->m_pushSession = session;
+
+    // the writer sends the writes in order, the request starts once the writes queued until now are sent
+    auto written = std::make_shared<std::promise<void>>();
+    this->m_writer.post([written]() { written->set_value(); });
+
+    return std::async(std::launch::async, [airports = std::move(airports), written = written->get_future(),
+                                           writeSequence = this->m_writeSequence]() {
+        written.wait();
+        const auto start = std::chrono::steady_clock::now();
+
+        BackendData data;
+        data.writeSequence = writeSequence;
+        data.pilots = Server::instance().getPilots(airports);
+        data.duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        return data;
+    });
+}
+
+bool DataManager::fetchDue(std::string_view airport, std::size_t cycle) {
+    const auto key = AirportSet::pack(airport);
+    for (const auto& partition : std::as_const(this->m_partitions)) {
+        if (key != partition->key) continue;
+
+        // the tiers of the last published generation, the pilots added since then are hot
+        std::lock_guard guard(partition->lock);
+        const auto& metrics = partition->metrics;
+        return 0 != metrics.hotPilots || true == partition->addedPilots ||
+               (0 != metrics.warmPilots && true == DataManager::refreshDue(RefreshTier::Warm, cycle)) ||
+               (0 != metrics.coldPilots && true == DataManager::refreshDue(RefreshTier::Cold, cycle));
+    }
+
+    // no pilot of the airport is tracked, the backend data would be ignored
+    return false;
 }
 
 void DataManager::handleTagFunction(MessageType type, const std::string callsign,
                                     const std::chrono::utc_clock::time_point value) {
     // do not handle the tag function if the aircraft does not exist or the client is not master
     if (false == this->checkPilotExists(callsign) || false == Server::instance().getMaster()) return;
+    const auto id = this->m_callsigns.find(callsign);
+    this->m_lastInteraction.store(__steadyMilliseconds());
 
     // queue the update message which will be sent to the backend
     {
         std::lock_guard guard(this->m_asyncMessagesLock);
-        this->m_asynchronousMessages.push_back({type, callsign, value});
+        this->m_asynchronousMessages.push_back({type, id, callsign, value});
     }
 
     // set the data locally, gives feedback to user that the action was handled, might get overwritten again in the
     // update cycle if the backend does not accept the message
-    std::lock_guard guard(this->m_pilotLock);
-    auto it = this->m_pilots.find(callsign);
-    auto& pilot = it->second[ConsolidatedData];
+    std::shared_lock partitionGuard(this->m_partitionLock);
+    Slot slot;
+    const auto partition = this->locatePilot(id, slot);
+    if (nullptr == partition) return;
+
+    std::lock_guard guard(partition->lock);
+    const LocalEdit edit{type, slot, value, std::chrono::utc_clock::now()};
+    DataManager::applyLocalEdit(*partition->published, edit);
+
+    // the worker thread may be building the next generation at the moment, the edit is replayed when it is published
+    partition->localEdits.push_back(edit);
+    partition->changedPilots.push_back(slot);
+}
 
-    pilot.lastUpdate = std::chrono::utc_clock::now();
+void DataManager::applyLocalEdit(PilotTable& pilots, const LocalEdit& edit) {
+    if (edit.slot >= pilots.size() || false == pilots[edit.slot].has_value()) return;
+    auto& pilot = pilots[edit.slot].value().acdm;
+    const auto& value = edit.value;
 
-    switch (type) {
+    pilot.lastUpdate = edit.timeIssued;
+
+    switch (edit.type) {
         case MessageType::UpdateEXOT:
             pilot.exot = value;
             pilot.tsat = types::defaultTime;
@@ -212,7 +774,7 @@ void DataManager::handleTagFunction(MessageType type, const std::string callsign
             pilot.atot = types::defaultTime;
             break;
         case MessageType::UpdateTOBT: {
-            bool resetTsat = value >= pilot.tsat;
+            bool resetTsat = value >= pilot.tsat.get();
 
             pilot.tobt = value;
             if (true == resetTsat) pilot.tsat = types::defaultTime;
@@ -225,7 +787,7 @@ void DataManager::handleTagFunction(MessageType type, const std::string callsign
             break;
         }
         case MessageType::UpdateTOBTConfirmed: {
-            bool resetTsat = value == types::defaultTime || value >= pilot.tsat;
+            bool resetTsat = value == types::defaultTime || value >= pilot.tsat.get();
 
             pilot.tobt = value;
             if (true == resetTsat) pilot.tsat = types::defaultTime;
@@ -267,7 +829,7 @@ void DataManager::handleTagFunction(MessageType type, const std::string callsign
             pilot.asrt = types::defaultTime;
             break;
         case MessageType::ResetTOBTConfirmed:
-            pilot.tobt_state = "GUESS";
+            pilot.tobtState.assign("GUESS");
             break;
         case MessageType::ResetAORT:
             pilot.aort = types::defaultTime;
@@ -276,74 +838,149 @@ void DataManager::handleTagFunction(MessageType type, const std::string callsign
             pilot.aobt = types::defaultTime;
             break;
         case MessageType::ResetPilot:
-            this->m_pilots.erase(it);
+            pilots[edit.slot].reset();
             break;
         default:
             break;
     }
 }
 
-DataManager::MessageType DataManager::deltaEuroscopeToBackend(const std::array<types::Pilot, 3>& data,
+DataManager::MessageType DataManager::deltaEuroscopeToBackend(const types::PilotRecord& data,
                                                               Json::Value& message) {
     message.clear();
 
-    if (data[ServerData].callsign == "" && data[EuroscopeData].callsign != "") {
+    if (false == data.hasServerData && false == data.callsign.empty()) {
         return DataManager::MessageType::Post;
     } else {
-        message["callsign"] = data[EuroscopeData].callsign;
+        const auto& euroscope = data.euroscope;
+        const auto& server = data.server;
 
-        int deltaCount = 0;
+        message["callsign"] = data.callsign.str();
 
-        if (data[EuroscopeData].inactive != data[ServerData].inactive) {
-            message["inactive"] = data[EuroscopeData].inactive;
-            deltaCount += 1;
-        }
+        const int deltaCount = types::deltaPilot(euroscope, server, message);
 
-        auto lastDelta = deltaCount;
-        message["position"] = Json::Value();
-        if (data[EuroscopeData].latitude != data[ServerData].latitude) {
-            message["position"]["lat"] = data[EuroscopeData].latitude;
-            deltaCount += 1;
-        }
-        if (data[EuroscopeData].longitude != data[ServerData].longitude) {
-            message["position"]["lon"] = data[EuroscopeData].longitude;
-            deltaCount += 1;
-        }
-        if (deltaCount == lastDelta) message.removeMember("position");
-
-        // patch flightplan data
-        lastDelta = deltaCount;
-        message["flightplan"] = Json::Value();
-        if (data[EuroscopeData].origin != data[ServerData].origin) {
-            deltaCount += 1;
-            message["flightplan"]["departure"] = data[EuroscopeData].origin;
-        }
-        if (data[EuroscopeData].destination != data[ServerData].destination) {
-            deltaCount += 1;
-            message["flightplan"]["arrival"] = data[EuroscopeData].destination;
-        }
-        if (deltaCount == lastDelta) message.removeMember("flightplan");
-
-        // patch clearance data
-        lastDelta = deltaCount;
-        message["clearance"] = Json::Value();
-        if (data[EuroscopeData].runway != data[ServerData].runway) {
-            deltaCount += 1;
-            message["clearance"]["dep_rwy"] = data[EuroscopeData].runway;
-        }
-        if (data[EuroscopeData].sid != data[ServerData].sid) {
-            deltaCount += 1;
-            message["clearance"]["sid"] = data[EuroscopeData].sid;
+        return deltaCount != 0 ? DataManager::MessageType::Patch : DataManager::MessageType::None;
+    }
+}
+
+void DataManager::mergePushedPilots() {
+    const auto pilots = this->m_push.takePilots();
+
+    // the pushed data is merged like a tag function edit, the next cycle copies it into the back buffer
+    for (const auto& pushedPilot : pilots) {
+        Slot slot;
+        const auto partition = this->locatePilot(this->m_callsigns.find(pushedPilot.callsign), slot);
+        if (nullptr == partition) continue;
+
+        std::lock_guard guard(partition->lock);
+        auto& published = *partition->published;
+        if (slot >= published.size() || false == published[slot].has_value()) continue;
+
+        this->consolidateData(published[slot].value(), pushedPilot);
+        partition->changedPilots.push_back(slot);
+    }
+}
+
+void DataManager::enablePushChannel(const std::string& url, std::chrono::seconds consistencyInterval) {
+    this->m_pushConsistencyMilliseconds.store(
+        std::chrono::duration_cast<std::chrono::milliseconds>(consistencyInterval).count());
+    this->m_push.setUrl(url);
+}
+
+void DataManager::disablePushChannel() { this->m_push.setUrl(""); }
+
+void DataManager::enableSnapshot(const std::string& filename) {
+    std::lock_guard guard(this->m_snapshotLock);
+    this->m_snapshotFile = filename;
+    this->m_restoreSnapshot = true;
+}
+
+void DataManager::restoreSnapshot() {
+    std::string filename;
+    {
+        std::lock_guard guard(this->m_snapshotLock);
+        if (false == this->m_restoreSnapshot) return;
+        this->m_restoreSnapshot = false;
+        filename = this->m_snapshotFile;
+    }
+
+    const auto activeAirports = this->m_activeAirports.load(std::memory_order_acquire);
+    std::size_t restored = 0;
+    for (auto& pilot : PilotSnapshot::load(filename, __snapshotMaximumAge)) {
+        const auto origin = pilot.euroscope.origin.str();
+        if (false == activeAirports->empty() && false == activeAirports->contains(origin)) continue;
+
+        const auto id = this->m_callsigns.intern(pilot.callsign.view());
+        if (id < this->m_locations.size() && InvalidPartition != this->m_locations[id].partition) continue;
+
+        const auto partitionIndex = this->partitionOf(origin);
+        auto& partition = *this->m_partitions[partitionIndex];
+        const PilotLocation location{partitionIndex, DataManager::allocateSlot(partition)};
+
+        // the record is part of both generations, the tags show it before the first cycle
+        {
+            std::lock_guard guard(partition.lock);
+            for (auto& table : partition.tables) {
+                if (location.slot >= table.size()) table.resize(location.slot + 1);
+                table[location.slot] = pilot;
+            }
         }
-        if (deltaCount == lastDelta) message.removeMember("clearance");
 
-        return deltaCount != 0 ? DataManager::MessageType::Patch : DataManager::MessageType::None;
+        std::unique_lock guard(this->m_partitionLock);
+        if (id >= this->m_locations.size()) this->m_locations.resize(this->m_callsigns.size());
+        this->m_locations[id] = location;
+        restored += 1;
     }
+
+    if (0 != restored)
+        Logger::instance().log(Logger::LogSender::DataManager,
+                               "Restored " + std::to_string(restored) + " pilots from the snapshot",
+                               Logger::LogLevel::Info);
+}
+
+void DataManager::saveSnapshot() {
+    this->m_lastSnapshot = std::chrono::steady_clock::now();
+
+    std::string filename;
+    {
+        // do not replace a snapshot which has not been restored yet
+        std::lock_guard guard(this->m_snapshotLock);
+        if (true == this->m_restoreSnapshot) return;
+        filename = this->m_snapshotFile;
+    }
+    if (true == filename.empty()) return;
+
+    std::vector<types::PilotRecord> pilots;
+    for (const auto& partition : std::as_const(this->m_partitions)) {
+        std::lock_guard guard(partition->lock);
+        for (const auto& pilot : *partition->published) {
+            if (true == pilot.has_value()) pilots.push_back(pilot.value());
+        }
+    }
+
+    PilotSnapshot::save(filename, pilots);
+}
+
+void DataManager::setActiveAirports(AirportSet activeAirports) {
+    this->m_push.setAirports(activeAirports.names());
+
+    std::lock_guard guard(this->m_airportLock);
+
+    // the replaced set is freed by the worker thread, a reader may still use it without holding a lock
+    this->m_airportSets.push_back(std::make_unique<const AirportSet>(std::move(activeAirports)));
+    this->m_activeAirports.store(this->m_airportSets.back().get(), std::memory_order_release);
 }
 
-void DataManager::setActiveAirports(const std::list<std::string> activeAirports) {
+void DataManager::retireAirportSets() {
     std::lock_guard guard(this->m_airportLock);
-    this->m_activeAirports = activeAirports;
+
+    // the worker thread holds no set between the cycles and the UI thread only reads the sets it published itself,
+    // the previous set is kept for a reader which loaded it right before it was replaced
+    while (this->m_airportSets.size() > 2) this->m_airportSets.pop_front();
+}
+
+bool DataManager::isActiveAirport(std::string_view icao) const {
+    return this->m_activeAirports.load(std::memory_order_acquire)->contains(icao);
 }
 
 void DataManager::queueFlightplanUpdate(EuroScopePlugIn::CFlightPlan flightplan) {
@@ -351,160 +988,280 @@ void DataManager::queueFlightplanUpdate(EuroScopePlugIn::CFlightPlan flightplan)
         nullptr == flightplan.GetFlightPlanData().GetOrigin())
         return;
 
+    // filter before the conversion, most flightplans of a session do not depart from an active airport
+    if (false == this->isActiveAirport(flightplan.GetFlightPlanData().GetOrigin())) return;
+
+    // intern the callsign once at ingest, the worker thread only handles ids afterwards
+    const auto id = this->m_callsigns.intern(flightplan.GetCallsign());
+
+    // drop updates which do not change any extracted field, as long as the pilot is tracked
+    const auto fingerprint = DataManager::fingerprint(flightplan);
+    const auto tracked = this->checkPilotExists(flightplan.GetCallsign());
+    {
+        std::lock_guard guard(this->m_euroscopeUpdatesLock);
+        if (id >= this->m_fingerprints.size()) this->m_fingerprints.resize(id + 1, 0);
+
+        if (true == tracked && fingerprint == this->m_fingerprints[id]) {
+            this->m_droppedUpdates += 1;
+            return;
+        }
+        this->m_fingerprints[id] = fingerprint;
+    }
+
     auto pilot = this->CFlightPlanToPilot(flightplan);
 
     std::lock_guard guard(this->m_euroscopeUpdatesLock);
-    this->m_euroscopeFlightplanUpdates.push_back({std::chrono::utc_clock::now(), pilot});
-}
-
-void DataManager::consolidateWithBackend(std::map<std::string, std::array<types::Pilot, 3U>>& pilots) {
-    // retrieving backend data
-    auto backendPilots = Server::instance().getPilots(this->m_activeAirports);
-
-    for (auto pilot = pilots.begin(); pilots.end() != pilot;) {
-        // update backend data & consolidate
-        bool removeFlight = pilot->second[ServerData].inactive == true;
-        for (auto updateIt = backendPilots.begin(); updateIt != backendPilots.end(); ++updateIt) {
-            if (updateIt->callsign == pilot->second[EuroscopeData].callsign) {
-                Logger::instance().log(
-                    Logger::LogSender::DataManager,
-                    "Updating " + pilot->second[EuroscopeData].callsign + " with" + updateIt->callsign,
-                    Logger::LogLevel::Info);
-                pilot->second[ServerData] = *updateIt;
-                DataManager::consolidateData(pilot->second);
-                removeFlight = false;
-                updateIt = backendPilots.erase(updateIt);
-                break;
-            }
+    this->m_euroscopeFlightplanUpdates.push_back({std::chrono::utc_clock::now(), id, pilot});
+    this->m_queuedUpdates += 1;
+}
+
+std::uint64_t DataManager::fingerprint(const EuroScopePlugIn::CFlightPlan& flightplan) {
+    const auto position = flightplan.GetFPTrackPosition().GetPosition();
+    const auto data = flightplan.GetFlightPlanData();
+
+    // the fields extracted by CFlightPlanToPilot, the EOBT is hashed before it is parsed
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    hash = __fingerprint(hash, position.m_Latitude);
+    hash = __fingerprint(hash, position.m_Longitude);
+    hash = __fingerprint(hash, data.GetOrigin());
+    hash = __fingerprint(hash, data.GetDestination());
+    hash = __fingerprint(hash, data.GetDepartureRwy());
+    hash = __fingerprint(hash, data.GetSidName());
+    hash = __fingerprint(hash, data.GetEstimatedDepartureTime());
+    return hash;
+}
+
+std::vector<std::string> DataManager::statistics() {
+    std::vector<std::string> statistics;
+
+    {
+        std::lock_guard guard(this->m_euroscopeUpdatesLock);
+
+        const auto total = this->m_queuedUpdates + this->m_droppedUpdates;
+        const auto dropRate = 0 != total ? (100 * this->m_droppedUpdates) / total : 0;
+        statistics.push_back("EuroScope updates: " + std::to_string(this->m_queuedUpdates) + " queued, " +
+                             std::to_string(this->m_droppedUpdates) + " unchanged dropped (" +
+                             std::to_string(dropRate) + "%)");
+    }
+
+    {
+        std::lock_guard guard(this->m_metricsLock);
+
+        const auto& cycle = this->m_cycleMetrics;
+        const auto milliseconds = [](const std::chrono::microseconds& duration) {
+            return std::to_string(duration.count() / 1000) + "." + std::to_string((duration.count() % 1000) / 100);
+        };
+        statistics.push_back("Cycle: " + milliseconds(cycle.total) + " ms (synchronize " +
+                             milliseconds(cycle.synchronize) + ", messages " + milliseconds(cycle.messages) +
+                             ", fetch wait " + milliseconds(cycle.fetchWait) + ", routing " +
+                             milliseconds(cycle.routing) + ", partitions " + milliseconds(cycle.partitions) +
+                             ", transmissions " + milliseconds(cycle.transmissions) + "), fetch " +
+                             milliseconds(cycle.fetch) + " ms");
+
+        const auto& writes = this->m_writeMetrics;
+        const auto average =
+            0 != writes.writes ? writes.duration / static_cast<std::int64_t>(writes.writes) : writes.duration;
+        statistics.push_back("Writes: " + std::to_string(writes.writes) + " sent, " +
+                             std::to_string(this->m_writer.pending()) + " pending, " + milliseconds(average) +
+                             " ms average");
+    }
+
+    statistics.push_back(this->m_push.status());
+
+    std::shared_lock partitionGuard(this->m_partitionLock);
+    for (const auto& partition : std::as_const(this->m_partitions)) {
+        std::lock_guard guard(partition->lock);
+
+        const auto& metrics = partition->metrics;
+        statistics.push_back(partition->airport + ": " + std::to_string(metrics.pilots) + " pilots (" +
+                             std::to_string(metrics.hotPilots) + " hot, " + std::to_string(metrics.warmPilots) +
+                             " warm, " + std::to_string(metrics.coldPilots) + " cold, " +
+                             std::to_string(metrics.refreshedPilots) + " refreshed), " +
+                             std::to_string(metrics.euroscopeUpdates) + " EuroScope updates, " +
+                             std::to_string(metrics.backendUpdates) + " backend updates, " +
+                             std::to_string(metrics.transmissions) + " messages, " +
+                             std::to_string(metrics.processingTime.count()) + " us");
+    }
+
+    return statistics;
+}
+
+void DataManager::routeBackendUpdates(std::list<types::Pilot> backendPilots) {
+    for (auto& backendPilot : backendPilots) {
+        Slot slot;
+        const auto partition = this->locatePilot(this->m_callsigns.find(backendPilot.callsign), slot);
+        if (nullptr != partition) partition->backendUpdates.emplace_back(slot, std::move(backendPilot));
+    }
+}
+
+void DataManager::consolidateWithBackend(Partition& partition) {
+    auto& pilots = *partition.next;
+
+    // update backend data & consolidate
+    std::vector<bool> updatedPilots(pilots.size(), false);
+    for (const auto& [slot, backendPilot] : std::as_const(partition.backendUpdates)) {
+        // the backend filters by airport only, the rows of the pilots which are not due are merged as well instead of
+        // requesting them again in their own cycle
+        if (slot >= pilots.size() || false == pilots[slot].has_value()) continue;
+
+        // the row was requested before the last write of the pilot, merging it would revert the write
+        if (slot < partition.pendingWrites.size() && 0 != partition.pendingWrites[slot].sequence) {
+            if (partition.pendingWrites[slot].sequence > this->m_backendWriteSequence) continue;
+            partition.pendingWrites[slot] = PendingWrite();
         }
 
-        // remove pilot if he has been flagged as inactive from the backend
-        if (true == removeFlight) {
-            pilot = pilots.erase(pilot);
-        } else {
-            ++pilot;
+        auto& pilot = pilots[slot].value();
+        Logger::instance().logLimited(Logger::LogSender::DataManager, "consolidateWithBackend", __perPilotLogLimit,
+                                      "Updating " + pilot.callsign.str() + " with" + backendPilot.callsign,
+                                      Logger::LogLevel::Info,
+                                      {backendPilot.callsign, backendPilot.origin, "BackendUpdate"});
+        DataManager::consolidateData(pilot, backendPilot);
+        updatedPilots[slot] = true;
+        partition.generationChanges.push_back(slot);
+    }
+    partition.backendUpdates.clear();
+
+    // remove pilot if he has been flagged as inactive from the backend
+    for (std::size_t slot = 0; slot < pilots.size(); ++slot) {
+        if (true == pilots[slot].has_value() && false == updatedPilots[slot] &&
+            true == pilots[slot].value().server.inactive) {
+            partition.releasedSlots.emplace_back(this->m_callsigns.find(pilots[slot].value().callsign.view()),
+                                                 static_cast<Slot>(slot));
+            pilots[slot].reset();
+            partition.generationChanges.push_back(static_cast<Slot>(slot));
         }
     }
 }
 
-void DataManager::consolidateData(std::array<types::Pilot, 3>& pilot) {
-    if (pilot[EuroscopeData].callsign == pilot[ServerData].callsign) {
-        // backend data
-        pilot[ConsolidatedData].inactive = pilot[ServerData].inactive;
-        pilot[ConsolidatedData].lastUpdate = pilot[ServerData].lastUpdate;
-
-        pilot[ConsolidatedData].eobt = pilot[ServerData].eobt;
-        pilot[ConsolidatedData].tobt = pilot[ServerData].tobt;
-        pilot[ConsolidatedData].tobt_state = pilot[ServerData].tobt_state;
-        pilot[ConsolidatedData].ctot = pilot[ServerData].ctot;
-        pilot[ConsolidatedData].ttot = pilot[ServerData].ttot;
-        pilot[ConsolidatedData].tsat = pilot[ServerData].tsat;
-        pilot[ConsolidatedData].exot = pilot[ServerData].exot;
-        pilot[ConsolidatedData].asat = pilot[ServerData].asat;
-        pilot[ConsolidatedData].aobt = pilot[ServerData].aobt;
-        pilot[ConsolidatedData].atot = pilot[ServerData].atot;
-        pilot[ConsolidatedData].asrt = pilot[ServerData].asrt;
-        pilot[ConsolidatedData].aort = pilot[ServerData].aort;
-
-        pilot[ConsolidatedData].measures = pilot[ServerData].measures;
-        pilot[ConsolidatedData].hasBooking = pilot[ServerData].hasBooking;
-        pilot[ConsolidatedData].taxizoneIsTaxiout = pilot[ServerData].taxizoneIsTaxiout;
-
-        // EuroScope data
-        pilot[ConsolidatedData].latitude = pilot[EuroscopeData].latitude;
-        pilot[ConsolidatedData].longitude = pilot[EuroscopeData].longitude;
-
-        pilot[ConsolidatedData].origin = pilot[EuroscopeData].origin;
-        pilot[ConsolidatedData].destination = pilot[EuroscopeData].destination;
-        pilot[ConsolidatedData].runway = pilot[EuroscopeData].runway;
-        pilot[ConsolidatedData].sid = pilot[EuroscopeData].sid;
-
-        logging::Logger::instance().log(Logger::LogSender::DataManager, "Consolidated " + pilot[ServerData].callsign,
-                                        logging::Logger::LogLevel::Info);
+void DataManager::consolidateData(types::PilotRecord& pilot, const types::Pilot& backendPilot) {
+    if (pilot.callsign.view() == backendPilot.callsign) {
+        // the backend defines the A-CDM data, the EuroScope overlay provides the position and flightplan data
+        pilot.updateServer(backendPilot);
+
+        logging::Logger::instance().logLimited(
+            Logger::LogSender::DataManager, "consolidateData", __perPilotLogLimit,
+            "Consolidated " + backendPilot.callsign, logging::Logger::LogLevel::Info,
+            {backendPilot.callsign, pilot.euroscope.origin.str(), "Consolidate"});
     } else {
         logging::Logger::instance().log(Logger::LogSender::DataManager,
-                                        "Callsign mismatch during consolidation: " + pilot[EuroscopeData].callsign +
-                                            ", " + pilot[ServerData].callsign,
-                                        logging::Logger::LogLevel::Critical);
+                                        "Callsign mismatch during consolidation: " + pilot.callsign.str() + ", " +
+                                            backendPilot.callsign,
+                                        logging::Logger::LogLevel::Critical,
+                                        {pilot.callsign.str(), pilot.euroscope.origin.str(), "Consolidate"});
     }
 }
 
-void DataManager::processEuroScopeUpdates(std::map<std::string, std::array<types::Pilot, 3U>>& pilots) {
+void DataManager::routeEuroScopeUpdates() {
     // obtain a copy of the flightplan updates, clear the update list, consolidate flightplan updates
     this->m_euroscopeUpdatesLock.lock();
-    auto flightplanUpdates = this->m_euroscopeFlightplanUpdates;
+    auto flightplanUpdates = std::move(this->m_euroscopeFlightplanUpdates);
     this->m_euroscopeFlightplanUpdates.clear();
     this->m_euroscopeUpdatesLock.unlock();
 
     this->consolidateFlightplanUpdates(flightplanUpdates);
 
     for (auto& update : flightplanUpdates) {
-        bool found = false;
-
-        const auto pilot = update.data;
+        const auto partitionIndex = this->partitionOf(update.data.origin);
+        auto& target = *this->m_partitions[partitionIndex];
 
-        // find pilot in list
-        for (auto& pair : pilots) {
-            if (pilot.callsign == pair.first) {
-                Logger::instance().log(Logger::LogSender::DataManager, "Updated data of " + pilot.callsign,
-                                       Logger::LogLevel::Info);
+        if (update.id >= this->m_locations.size()) {
+            std::unique_lock guard(this->m_partitionLock);
+            this->m_locations.resize(this->m_callsigns.size());
+        }
 
-                pair.second[EuroscopeData] = pilot;
-                found = true;
-                break;
+        const auto location = this->m_locations[update.id];
+        if (partitionIndex != location.partition) {
+            const PilotLocation newLocation{partitionIndex, DataManager::allocateSlot(target)};
+            auto& targetPilots = *target.next;
+            if (newLocation.slot >= targetPilots.size()) targetPilots.resize(newLocation.slot + 1);
+
+            // the origin has changed, move the record to the partition of the new origin
+            if (InvalidPartition != location.partition) {
+                auto& source = *this->m_partitions[location.partition];
+                auto& sourceRecord = (*source.next)[location.slot];
+                targetPilots[newLocation.slot] = std::move(sourceRecord);
+                sourceRecord.reset();
+                source.releasedSlots.emplace_back(update.id, location.slot);
+
+                source.generationChanges.push_back(location.slot);
+                target.generationChanges.push_back(newLocation.slot);
             }
-        }
 
-        if (false == found) {
-            Logger::instance().log(Logger::LogSender::DataManager, "Added " + pilot.callsign, Logger::LogLevel::Info);
-            pilots.insert({pilot.callsign, {pilot, pilot, types::Pilot()}});
+            std::unique_lock guard(this->m_partitionLock);
+            this->m_locations[update.id] = newLocation;
         }
+
+        update.slot = this->m_locations[update.id].slot;
+        target.euroscopeUpdates.push_back(std::move(update));
     }
 }
 
-void DataManager::consolidateFlightplanUpdates(std::list<EuroscopeFlightplanUpdate>& inputList) {
-    std::list<DataManager::EuroscopeFlightplanUpdate> resultList;
+void DataManager::processEuroScopeUpdates(Partition& partition) {
+    auto& pilots = *partition.next;
 
-    for (const auto& currentUpdate : inputList) {
-        auto pilot = currentUpdate.data;
+    for (const auto& update : std::as_const(partition.euroscopeUpdates)) {
+        const auto& pilot = update.data;
 
-        // only handle updates for active airports
-        {
-            std::lock_guard guard(this->m_airportLock);
-            bool flightDepartsFromActiveAirport = std::find(m_activeAirports.begin(), m_activeAirports.end(),
-                                                            std::string(pilot.origin)) != m_activeAirports.end();
-            if (false == flightDepartsFromActiveAirport) continue;
+        if (update.slot >= pilots.size()) pilots.resize(partition.slots);
+
+        if (true == pilots[update.slot].has_value()) {
+            Logger::instance().logLimited(Logger::LogSender::DataManager, "processEuroScopeUpdates",
+                                          __perPilotLogLimit, "Updated data of " + pilot.callsign,
+                                          Logger::LogLevel::Info, {pilot.callsign, pilot.origin, "EuroscopeUpdate"});
+
+            pilots[update.slot].value().updateEuroscope(pilot);
+        } else {
+            Logger::instance().log(Logger::LogSender::DataManager, "Added " + pilot.callsign, Logger::LogLevel::Info,
+                                   {pilot.callsign, pilot.origin, "Added"});
+            pilots[update.slot].emplace(pilot);
         }
+        partition.generationChanges.push_back(update.slot);
+    }
+    partition.euroscopeUpdates.clear();
+}
+
+void DataManager::consolidateFlightplanUpdates(std::vector<EuroscopeFlightplanUpdate>& inputList) {
+    std::vector<DataManager::EuroscopeFlightplanUpdate> resultList;
+    std::unordered_map<CallsignRegistry::Id, std::size_t> resultIndices;
+    resultList.reserve(inputList.size());
+
+    for (const auto& currentUpdate : inputList) {
+        // the active airports may have changed since the update was queued
+        if (false == this->isActiveAirport(currentUpdate.data.origin)) continue;
 
         // Check if the flight plan already exists in the result list
-        auto it = std::find_if(resultList.begin(), resultList.end(),
-                               [&currentUpdate](const EuroscopeFlightplanUpdate& existingUpdate) {
-                                   return existingUpdate.data.callsign == currentUpdate.data.callsign;
-                               });
+        const auto index = resultIndices.find(currentUpdate.id);
 
-        if (it != resultList.end()) {
+        if (index != resultIndices.end()) {
+            auto it = resultList.begin() + index->second;
             // Flight plan with the same callsign exists
             // Check if the timeIssued is newer
             if (currentUpdate.timeIssued > it->timeIssued) {
                 // Update with the newer data
                 *it = currentUpdate;
-                Logger::instance().log(Logger::LogSender::DataManager,
-                                       "Updated: " + std::string(currentUpdate.data.callsign), Logger::LogLevel::Info);
+                Logger::instance().logLimited(
+                    Logger::LogSender::DataManager, "consolidateFlightplanUpdates:updated", __updateQueueLogLimit,
+                    "Updated: " + std::string(currentUpdate.data.callsign), Logger::LogLevel::Info,
+                    {currentUpdate.data.callsign, currentUpdate.data.origin, "QueueUpdated"});
             } else {
                 // Existing data is already newer, no update needed
-                Logger::instance().log(Logger::LogSender::DataManager,
-                                       "Skipped old update for: " + std::string(currentUpdate.data.callsign),
-                                       Logger::LogLevel::Info);
+                Logger::instance().logLimited(
+                    Logger::LogSender::DataManager, "consolidateFlightplanUpdates:skipped", __updateQueueLogLimit,
+                    "Skipped old update for: " + std::string(currentUpdate.data.callsign), Logger::LogLevel::Info,
+                    {currentUpdate.data.callsign, currentUpdate.data.origin, "QueueSkipped"});
             }
         } else {
             // Flight plan with the callsign doesn't exist, add it to the result list
+            resultIndices.emplace(currentUpdate.id, resultList.size());
             resultList.push_back(currentUpdate);
-            Logger::instance().log(Logger::LogSender::DataManager,
-                                   "Update added: " + std::string(currentUpdate.data.callsign), Logger::LogLevel::Info);
+            Logger::instance().logLimited(
+                Logger::LogSender::DataManager, "consolidateFlightplanUpdates:added", __updateQueueLogLimit,
+                "Update added: " + std::string(currentUpdate.data.callsign), Logger::LogLevel::Info,
+                {currentUpdate.data.callsign, currentUpdate.data.origin, "QueueAdded"});
         }
     }
 
-    inputList = resultList;
+    inputList = std::move(resultList);
 }
 
 types::Pilot DataManager::CFlightPlanToPilot(const EuroScopePlugIn::CFlightPlan flightplan) {
@@ -1,10 +1,20 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <list>
-#include <map>
+#include <memory>
 #include <mutex>
+#include <limits>
+#include <optional>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #pragma warning(push, 0)
 #include "EuroScopePlugIn.h"
@@ -12,14 +22,19 @@
 
 #include <json/json.h>
 
+#include "core/AirportSet.h"
+#include "core/CallsignRegistry.h"
+#include "core/PushChannel.h"
+#include "core/WorkerPool.h"
 #include "types/Pilot.h"
+#include "types/PilotRecord.h"
 
 using namespace vacdm;
 
 namespace vacdm::core {
 
-constexpr int maxUpdateCycleSeconds = 10;
-constexpr int minUpdateCycleSeconds = 1;
+constexpr int maxUpdateCycleMilliseconds = 30000;
+constexpr int minUpdateCycleMilliseconds = 250;
 class DataManager {
    private:
     DataManager();
@@ -29,7 +44,6 @@ class DataManager {
     bool m_stop;
 
     void run();
-    int updateCycleSeconds = 5;
 
    public:
     ~DataManager();
@@ -40,7 +54,12 @@ class DataManager {
     DataManager &operator=(DataManager &&) = delete;
     static DataManager &instance();
 
-    std::string setUpdateCycleSeconds(const int newUpdateCycleSeconds);
+    /// @brief runs the update cycle with a fixed cadence
+    std::string setUpdateCycle(std::chrono::milliseconds cycle);
+    /// @brief adapts the cadence to the activity and the backend latency, it stays within the bounds
+    std::string setAdaptiveUpdateCycle(std::chrono::milliseconds minimum, std::chrono::milliseconds maximum);
+    /// @brief returns the current cadence and mode as human readable message
+    std::string updateCycleStatus();
 
     enum class MessageType {
         None,
@@ -63,54 +82,298 @@ class DataManager {
     };
 
    private:
-    std::mutex m_pilotLock;
-    std::map<std::string, std::array<types::Pilot, 3>> m_pilots;
-    std::mutex m_airportLock;
-    std::list<std::string> m_activeAirports;
+    /// @brief compact records of the pilots of one partition, indexed by the slot of the pilot
+    typedef std::vector<std::optional<types::PilotRecord>> PilotTable;
+    typedef std::uint32_t Slot;
+
+    static constexpr std::uint32_t InvalidPartition = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief position of a pilot in the partitioned pilot store
+    struct PilotLocation {
+        std::uint32_t partition = InvalidPartition;
+        Slot slot = 0;
+    };
 
     struct EuroscopeFlightplanUpdate {
         std::chrono::utc_clock::time_point timeIssued;
+        CallsignRegistry::Id id;
         types::Pilot data;
+        Slot slot = 0;
+    };
+
+    struct LocalEdit {
+        MessageType type;
+        Slot slot;
+        std::chrono::utc_clock::time_point value;
+        std::chrono::utc_clock::time_point timeIssued;
     };
 
+    struct Transmission {
+        types::Pilot pilot;
+        MessageType type;
+        Json::Value message;
+        Slot slot;
+    };
+
+    /// @brief the last write of a pilot which is not contained in the merged backend data yet
+    struct PendingWrite {
+        /// @brief the sequence of the write, zero if no write is pending
+        std::uint64_t sequence = 0;
+        /// @brief the cycle which queued the write
+        std::size_t cycle = 0;
+    };
+
+    /// @brief refresh priority of a pilot, derived from the time to the TSAT or TOBT and the ground state
+    /// @details Hot pilots are refreshed in every cycle, warm and cold pilots only in every Nth cycle.
+    enum class RefreshTier : std::uint8_t { Hot, Warm, Cold };
+
+    struct PartitionMetrics {
+        std::size_t pilots = 0;
+        std::size_t hotPilots = 0;
+        std::size_t warmPilots = 0;
+        std::size_t coldPilots = 0;
+        /// @brief pilots which were merged with the backend or checked for changes in the cycle
+        std::size_t refreshedPilots = 0;
+        /// @brief pilots without AOBT whose TSAT, or TOBT if no TSAT is set, is close to now
+        std::size_t imminentPilots = 0;
+        std::size_t euroscopeUpdates = 0;
+        std::size_t backendUpdates = 0;
+        std::size_t transmissions = 0;
+        std::chrono::microseconds processingTime = std::chrono::microseconds(0);
+    };
+
+    /// @brief the pilots departing from one airport
+    /// @details The UI thread reads and edits the published generation. The partition task builds the next generation
+    /// in the back buffer without holding the lock and publishes it by swapping the pointers.
+    struct Partition {
+        AirportSet::PackedIcao key = AirportSet::InvalidIcao;
+        std::string airport;
+        /// @brief number of assigned slots, only used by the worker thread
+        Slot slots = 0;
+        /// @brief slots which are empty in both generations and are assigned to new pilots first, only used by the
+        /// worker thread
+        std::vector<Slot> freeSlots;
+        /// @brief slots which were emptied with the pilot which occupied them, they are released before the routing
+        /// of a later cycle, only used by the worker thread and the partition task
+        std::vector<std::pair<CallsignRegistry::Id, Slot>> releasedSlots;
+        /// @brief the pending writes indexed by the slot, only used by the worker thread and the partition task
+        std::vector<PendingWrite> pendingWrites;
+        /// @brief a pilot was added since the last cycle, it is hot until it is classified, only used by the worker
+        /// thread and the partition task
+        bool addedPilots = false;
+
+        std::mutex lock;
+        std::array<PilotTable, 2> tables;
+        PilotTable *published = &tables[0];
+        PilotTable *next = &tables[1];
+        /// @brief slots which differ between the published generation and the back buffer, guarded by lock
+        std::vector<Slot> changedPilots;
+        /// @brief tag function edits since the back buffer was synchronized, guarded by lock
+        std::vector<LocalEdit> localEdits;
+        /// @brief metrics of the last published generation, guarded by lock
+        PartitionMetrics metrics;
+
+        // input and output of the update cycle, only used by the worker thread and the partition task
+        std::vector<Slot> generationChanges;
+        std::vector<EuroscopeFlightplanUpdate> euroscopeUpdates;
+        std::vector<std::pair<Slot, types::Pilot>> backendUpdates;
+        std::vector<Transmission> transmissions;
+        /// @brief tier of every slot at the end of the last cycle, slots without tier are hot
+        std::vector<RefreshTier> tiers;
+    };
+
+    struct BackendData {
+        std::list<types::Pilot> pilots;
+        std::chrono::microseconds duration = std::chrono::microseconds(0);
+        /// @brief the sequence of the last write which was sent before the data was requested
+        std::uint64_t writeSequence = 0;
+    };
+
+    /// @brief duration of the stages of the last update cycle
+    struct CycleMetrics {
+        std::chrono::microseconds synchronize = std::chrono::microseconds(0);
+        std::chrono::microseconds messages = std::chrono::microseconds(0);
+        std::chrono::microseconds fetchWait = std::chrono::microseconds(0);
+        std::chrono::microseconds fetch = std::chrono::microseconds(0);
+        std::chrono::microseconds routing = std::chrono::microseconds(0);
+        std::chrono::microseconds partitions = std::chrono::microseconds(0);
+        std::chrono::microseconds transmissions = std::chrono::microseconds(0);
+        std::chrono::microseconds total = std::chrono::microseconds(0);
+    };
+
+    struct WriteMetrics {
+        std::size_t writes = 0;
+        std::chrono::microseconds duration = std::chrono::microseconds(0);
+    };
+
+    struct UpdateCycle {
+        bool adaptive = false;
+        std::chrono::milliseconds fixed = std::chrono::milliseconds(5000);
+        std::chrono::milliseconds minimum = std::chrono::milliseconds(1000);
+        std::chrono::milliseconds maximum = std::chrono::milliseconds(10000);
+        /// @brief the cadence in effect, equals fixed unless the cadence is adaptive
+        std::chrono::milliseconds current = std::chrono::milliseconds(5000);
+    };
+
+    std::mutex m_updateCycleLock;
+    UpdateCycle m_updateCycle;
+    /// @brief steady clock time of the last tag function in milliseconds, speeds up the adaptive cadence
+    std::atomic<std::int64_t> m_lastInteraction;
+    /// @brief returns the cadence in effect
+    std::chrono::milliseconds currentUpdateCycle();
+    /// @brief derives the cadence of the next cycle from the metrics of the finished cycle, if it is adaptive
+    std::chrono::milliseconds adaptUpdateCycle(const CycleMetrics &metrics, std::size_t pilots,
+                                               std::size_t imminentPilots);
+
+    /// @brief number of the current update cycle, only used by the worker thread
+    std::size_t m_cycle = 0;
+
+    com::PushChannel m_push;
+    /// @brief interval of the consistency polls while the push channel delivers the changes
+    std::atomic<std::int64_t> m_pushConsistencyMilliseconds;
+    /// @brief start of the last backend request and the push session it covers, only used by the worker thread
+    std::chrono::steady_clock::time_point m_lastBackendFetch;
+    std::uint64_t m_pushSession = 0;
+    /// @brief merges the pushed pilots into the published generation, called by the worker thread between the cycles
+    void mergePushedPilots();
+
+    /// @brief file of the warm-start snapshot, guarded by m_snapshotLock
+    std::mutex m_snapshotLock;
+    std::string m_snapshotFile;
+    bool m_restoreSnapshot = false;
+    std::chrono::steady_clock::time_point m_lastSnapshot;
+    /// @brief adds the pilots of the snapshot to the partitions, called by the worker thread before the first cycle
+    void restoreSnapshot();
+    /// @brief writes the published pilots to the snapshot
+    void saveSnapshot();
+
+    CallsignRegistry m_callsigns;
+    /// @brief guards the partition list and the pilot locations, both are only changed by the worker thread
+    std::shared_mutex m_partitionLock;
+    std::vector<std::unique_ptr<Partition>> m_partitions;
+    /// @brief location of every pilot, indexed by the interned callsign id
+    std::vector<PilotLocation> m_locations;
+    /// @brief declared before the writer, the queued writes update the metrics until the writer is destroyed
+    std::mutex m_metricsLock;
+    CycleMetrics m_cycleMetrics;
+    WriteMetrics m_writeMetrics;
+    WorkerPool m_workerPool;
+    /// @brief sends the queued writes to the backend in order while the worker thread continues with the cycle
+    WorkerPool m_writer;
+    /// @brief the backend data of the next cycle, requested while the current cycle is merged
+    std::future<BackendData> m_backendFetch;
+    /// @brief sequence of the last queued write of a pilot, only used by the worker thread
+    std::uint64_t m_writeSequence = 0;
+    /// @brief the write sequence of the backend data which is merged in the current cycle
+    std::uint64_t m_backendWriteSequence = 0;
+    /// @brief marks the pilot as written, its rows of backend data which was requested before are not merged
+    void markPendingWrite(Partition &partition, Slot slot);
+
+    /// @brief queues a request to the backend, the writes are sent in the order they are queued
+    void queueWrite(std::function<void()> write);
+    /// @brief requests the backend data of the active airports with pilots due in the cycle asynchronously
+    /// @details The request is sent after the writes which are queued until now.
+    std::future<BackendData> fetchBackendData(std::size_t cycle);
+    /// @brief checks if the pilots of the airport need the backend data in the cycle
+    bool fetchDue(std::string_view airport, std::size_t cycle);
+    /// @brief the published set of active airports, it is replaced as a whole and read without locking
+    std::atomic<const AirportSet *> m_activeAirports;
+    /// @brief owns the current and the previous published set, guarded by m_airportLock
+    std::mutex m_airportLock;
+    std::list<std::unique_ptr<const AirportSet>> m_airportSets;
+    /// @brief frees the replaced sets except the previous one, called by the worker thread between the cycles
+    void retireAirportSets();
+
     std::mutex m_euroscopeUpdatesLock;
-    std::list<EuroscopeFlightplanUpdate> m_euroscopeFlightplanUpdates;
+    std::vector<EuroscopeFlightplanUpdate> m_euroscopeFlightplanUpdates;
+    /// @brief fingerprint of the last queued update per pilot, guarded by m_euroscopeUpdatesLock
+    std::vector<std::uint64_t> m_fingerprints;
+    std::uint64_t m_queuedUpdates = 0;
+    std::uint64_t m_droppedUpdates = 0;
+
+    /// @brief hashes the fields which are extracted from the flightplan, the position is rounded to a deadband
+    static std::uint64_t fingerprint(const EuroScopePlugIn::CFlightPlan &flightplan);
+
+    /// @brief returns the partition of a pilot, the caller needs to hold m_partitionLock
+    /// @return the partition or nullptr if the pilot has not been added yet
+    Partition *locatePilot(CallsignRegistry::Id id, Slot &slot) const;
+    /// @brief assigns a slot to a new pilot of the partition, released slots are reused
+    static Slot allocateSlot(Partition &partition);
+    /// @brief frees the released slots which are still empty and removes the locations of their pilots
+    void releaseSlots();
+    /// @brief returns the index of the partition of an airport, creates the partition if needed
+    std::uint32_t partitionOf(const std::string &airport);
+    /// @brief runs the ingest, merge and delta stage of one partition and publishes it
+    /// @details Only the pilots which are due in the cycle or changed by EuroScope are merged and checked.
+    void processPartition(Partition &partition, bool master, std::size_t cycle);
+
+    static RefreshTier classify(const types::PilotRecord &pilot, const std::chrono::utc_clock::time_point &now);
+    static bool refreshDue(RefreshTier tier, std::size_t cycle);
 
     /// @brief consolidates all flightplan updates by throwing out old updates and keeping the most current ones
     /// @param list of flightplans to consolidate
-    void consolidateFlightplanUpdates(std::list<EuroscopeFlightplanUpdate> &list);
-    /// @brief updates the pilots with the saved EuroScope flightplan updates
-    /// @param pilots to update
-    void processEuroScopeUpdates(std::map<std::string, std::array<types::Pilot, 3U>> &pilots);
+    void consolidateFlightplanUpdates(std::vector<EuroscopeFlightplanUpdate> &list);
+    /// @brief assigns the queued EuroScope updates to the partitions of their origin airports
+    void routeEuroScopeUpdates();
+    /// @brief updates the pilots of a partition with the routed EuroScope flightplan updates
+    void processEuroScopeUpdates(Partition &partition);
     /// @brief gathers all information from EuroScope::CFlightPlan and converts it to type Pilot
     types::Pilot CFlightPlanToPilot(const EuroScopePlugIn::CFlightPlan flightplan);
-    /// @brief updates the local data with the data from the backend
-    /// @param pilots to update
-    void consolidateWithBackend(std::map<std::string, std::array<types::Pilot, 3U>> &pilots);
+    /// @brief assigns the backend data to the partitions of the pilots
+    void routeBackendUpdates(std::list<types::Pilot> backendPilots);
+    /// @brief updates the pilots of a partition with the routed backend data
+    void consolidateWithBackend(Partition &partition);
     /// @brief consolidates EuroScope and backend data
-    /// @param pilot
-    void consolidateData(std::array<types::Pilot, 3> &pilot);
+    /// @param pilot the record to update
+    /// @param backendPilot the data received from the backend
+    void consolidateData(types::PilotRecord &pilot, const types::Pilot &backendPilot);
 
-    MessageType deltaEuroscopeToBackend(const std::array<types::Pilot, 3> &data, Json::Value &message);
+    MessageType deltaEuroscopeToBackend(const types::PilotRecord &data, Json::Value &message);
 
     struct AsynchronousMessage {
         const MessageType type;
+        const CallsignRegistry::Id id;
         const std::string callsign;
         const std::chrono::utc_clock::time_point value;
     };
 
     std::mutex m_asyncMessagesLock;
     std::list<struct AsynchronousMessage> m_asynchronousMessages;
-    void processAsynchronousMessages(std::map<std::string, std::array<types::Pilot, 3U>> &pilots);
+    void processAsynchronousMessages();
+
+    /// @brief applies the local feedback of a tag function to the pilot data
+    static void applyLocalEdit(PilotTable &pilots, const LocalEdit &edit);
+    /// @brief copies the pilots changed since the last cycle from the published generation into the back buffer
+    static void synchronizeBackBuffer(Partition &partition);
+    /// @brief replays the local edits on the back buffer and publishes it as new generation
+    static void publishBackBuffer(Partition &partition, const PartitionMetrics &metrics);
 
    public:
-    void setActiveAirports(const std::list<std::string> activeAirports);
+    /// @brief restores the pilots of the last session from the snapshot and saves the pilots to it periodically
+    void enableSnapshot(const std::string &filename);
+    /// @brief subscribes to the pilot changes of the active airports, the polling only checks the consistency while
+    /// the stream is established
+    /// @param url the server-sent events endpoint
+    /// @param consistencyInterval the interval of the polls while the stream is established
+    void enablePushChannel(const std::string &url, std::chrono::seconds consistencyInterval);
+    void disablePushChannel();
+    void setActiveAirports(AirportSet activeAirports);
+    /// @brief checks lock-free if the airport is one of the active airports
+    bool isActiveAirport(std::string_view icao) const;
     void queueFlightplanUpdate(EuroScopePlugIn::CFlightPlan flightplan);
     void handleTagFunction(MessageType message, const std::string callsign,
                            const std::chrono::utc_clock::time_point value);
 
-    bool checkPilotExists(const std::string &callsign);
-    const types::Pilot getPilot(const std::string &callsign);
+    bool checkPilotExists(std::string_view callsign);
+    /// @brief returns the queued and dropped EuroScope updates and the metrics per airport as human readable messages
+    std::vector<std::string> statistics();
+    /// @brief returns the consolidated data of a pilot
+    /// @param callsign the callsign, e.g. directly from EuroScope
+    /// @return the pilot or std::nullopt if the pilot is unknown or the DataManager is paused
+    std::optional<types::Pilot> getPilot(std::string_view callsign);
+    /// @brief overwrites the pilot with the consolidated data, allocation-free if the pilot is reused for every call
+    /// @return false if the pilot is unknown or the DataManager is paused, the pilot is unchanged then
+    bool readPilot(std::string_view callsign, types::Pilot &pilot);
     void pause();
     void resume();
 };
@@ -0,0 +1,291 @@
+#include "MirrorSet.h"
+
+#include <algorithm>
+
+#include "log/Logger.h"
+
+using namespace vacdm::com;
+using namespace vacdm::logging;
+using namespace std::chrono_literals;
+
+// a mirror is considered down after these consecutive failures, the requests fail over to another mirror
+static constexpr std::uint32_t __failuresUntilFailover = 3;
+// the requests move to a mirror whose hedges answered first this often in a row
+static constexpr std::uint32_t __hedgeWinsUntilSwitch = 5;
+// the hedge delay is derived from the latencies once there are enough of them
+static constexpr std::size_t __minimumSamples = 10;
+static constexpr auto __defaultHedgeDelay = 500ms;
+static constexpr auto __minimumHedgeDelay = 50ms;
+static constexpr auto __maximumHedgeDelay = 1500ms;
+static constexpr auto __failedProbeInterval = 15s;
+static constexpr auto __idleProbeInterval = 60s;
+static constexpr long __probeTimeoutSeconds = 2;
+
+static std::size_t discardCurl(char *, std::size_t size, std::size_t nmemb, void *) { return size * nmemb; }
+
+MirrorSet::MirrorSet()
+    : m_thread(), m_lock(), m_wakeup(), m_stop(false), m_generation(0), m_mirrors(), m_current(0) {
+    this->m_thread = std::thread(&MirrorSet::run, this);
+}
+
+MirrorSet::~MirrorSet() {
+    {
+        std::lock_guard guard(this->m_lock);
+        this->m_stop = true;
+    }
+    this->m_wakeup.notify_all();
+    this->m_thread.join();
+}
+
+void MirrorSet::setUrls(const std::vector<std::string> &urls) {
+    {
+        std::lock_guard guard(this->m_lock);
+
+        this->m_mirrors.clear();
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto &url : urls) {
+            this->m_mirrors.push_back(Mirror());
+            this->m_mirrors.back().url = url;
+            this->m_mirrors.back().nextProbe = now;
+        }
+        this->m_current = 0;
+        this->m_generation += 1;
+    }
+    this->m_wakeup.notify_all();
+}
+
+std::size_t MirrorSet::current() {
+    std::lock_guard guard(this->m_lock);
+    return this->m_current;
+}
+
+std::string MirrorSet::url(std::size_t index) {
+    std::lock_guard guard(this->m_lock);
+    return index < this->m_mirrors.size() ? this->m_mirrors[index].url : "";
+}
+
+std::size_t MirrorSet::hedgeTarget() {
+    std::lock_guard guard(this->m_lock);
+    return this->fastestAlternative();
+}
+
+std::size_t MirrorSet::fastestAlternative() const {
+    std::size_t target = MirrorSet::None;
+    for (std::size_t i = 0; i < this->m_mirrors.size(); ++i) {
+        if (i == this->m_current || false == this->m_mirrors[i].healthy) continue;
+
+        if (MirrorSet::None == target ||
+            MirrorSet::percentile(this->m_mirrors[i], 50) < MirrorSet::percentile(this->m_mirrors[target], 50))
+            target = i;
+    }
+
+    return target;
+}
+
+std::chrono::milliseconds MirrorSet::hedgeDelay() {
+    std::lock_guard guard(this->m_lock);
+    if (this->m_current >= this->m_mirrors.size()) return __defaultHedgeDelay;
+
+    const auto &mirror = this->m_mirrors[this->m_current];
+    if (mirror.samples < __minimumSamples) return __defaultHedgeDelay;
+
+    return std::clamp<std::chrono::milliseconds>(MirrorSet::percentile(mirror, 95), __minimumHedgeDelay,
+                                                 __maximumHedgeDelay);
+}
+
+std::chrono::milliseconds MirrorSet::percentile(const Mirror &mirror, std::size_t percent) {
+    // mirrors without answers are ranked behind the measured ones
+    if (0 == mirror.samples) return std::chrono::milliseconds::max();
+
+    const auto count = std::min(mirror.samples, LatencySamples);
+    std::array<std::uint32_t, LatencySamples> latencies = mirror.latencies;
+    const auto nth = latencies.begin() + (count - 1) * percent / 100;
+    std::nth_element(latencies.begin(), nth, latencies.begin() + count);
+
+    return std::chrono::milliseconds(*nth);
+}
+
+void MirrorSet::recordSuccess(std::size_t index, std::chrono::milliseconds latency) {
+    std::lock_guard guard(this->m_lock);
+    if (index >= this->m_mirrors.size()) return;
+
+    auto &mirror = this->m_mirrors[index];
+    mirror.requests += 1;
+    mirror.latencies[mirror.samples % LatencySamples] = static_cast<std::uint32_t>(std::max<long long>(
+        0, std::min<long long>(latency.count(), std::numeric_limits<std::uint32_t>::max())));
+    mirror.samples += 1;
+    mirror.consecutiveFailures = 0;
+
+    if (false == mirror.healthy) {
+        mirror.healthy = true;
+        Logger::instance().log(Logger::LogSender::Server, "Mirror " + mirror.url + " answers again",
+                               Logger::LogLevel::Info);
+    }
+
+    // the current mirror answered first, the hedges of the others start counting again
+    if (index == this->m_current) {
+        for (auto &other : this->m_mirrors) other.hedgeWins = 0;
+    }
+}
+
+void MirrorSet::recordFailure(std::size_t index) {
+    std::lock_guard guard(this->m_lock);
+    if (index >= this->m_mirrors.size()) return;
+
+    auto &mirror = this->m_mirrors[index];
+    mirror.requests += 1;
+    mirror.failures += 1;
+    mirror.consecutiveFailures += 1;
+    if (mirror.consecutiveFailures < __failuresUntilFailover || false == mirror.healthy) return;
+
+    mirror.healthy = false;
+    mirror.nextProbe = std::chrono::steady_clock::now() + __failedProbeInterval;
+    Logger::instance().log(Logger::LogSender::Server,
+                           "Mirror " + mirror.url + " failed " + std::to_string(mirror.consecutiveFailures) +
+                               " times in a row, probing it every " + std::to_string(__failedProbeInterval.count()) +
+                               " s",
+                           Logger::LogLevel::Warning);
+
+    // without a healthy alternative the requests stay with the current mirror
+    const auto alternative = this->fastestAlternative();
+    if (index == this->m_current && MirrorSet::None != alternative) this->select(alternative, "failover");
+    this->m_wakeup.notify_all();
+}
+
+void MirrorSet::recordHedgeWin(std::size_t index) {
+    std::lock_guard guard(this->m_lock);
+    if (index >= this->m_mirrors.size() || index == this->m_current) return;
+
+    this->m_mirrors[index].hedgeWins += 1;
+    if (this->m_mirrors[index].hedgeWins >= __hedgeWinsUntilSwitch)
+        this->select(index, std::to_string(__hedgeWinsUntilSwitch) + " hedges in a row answered first");
+}
+
+void MirrorSet::select(std::size_t index, const std::string &reason) {
+    const auto previous = this->m_current;
+    this->m_current = index;
+    for (auto &mirror : this->m_mirrors) mirror.hedgeWins = 0;
+
+    // the previous mirror is probed from now on to keep its latency up to date
+    if (previous < this->m_mirrors.size())
+        this->m_mirrors[previous].nextProbe = std::chrono::steady_clock::now() +
+                                              (true == this->m_mirrors[previous].healthy ? __idleProbeInterval
+                                                                                         : __failedProbeInterval);
+
+    Logger::instance().log(Logger::LogSender::Server,
+                           "Switched from mirror " + (previous < this->m_mirrors.size() ? this->m_mirrors[previous].url
+                                                                                        : std::string("-")) +
+                               " to " + this->m_mirrors[index].url + " (" + reason + ")",
+                           Logger::LogLevel::Warning);
+}
+
+void MirrorSet::run() {
+    const auto socket = curl_easy_init();
+    if (nullptr != socket) {
+        curl_easy_setopt(socket, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(socket, CURLOPT_SSL_VERIFYHOST, 0L);
+        curl_easy_setopt(socket, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
+        curl_easy_setopt(socket, CURLOPT_HTTPGET, 1L);
+        curl_easy_setopt(socket, CURLOPT_WRITEFUNCTION, discardCurl);
+        curl_easy_setopt(socket, CURLOPT_ACCEPT_ENCODING, "");
+        curl_easy_setopt(socket, CURLOPT_TIMEOUT, __probeTimeoutSeconds);
+    }
+
+    while (true) {
+        std::size_t index = MirrorSet::None;
+        std::string url;
+        {
+            std::unique_lock guard(this->m_lock);
+
+            // the current mirror is measured by the regular requests, only a single mirror needs no probes
+            const auto due = [this]() {
+                std::size_t next = MirrorSet::None;
+                for (std::size_t i = 0; i < this->m_mirrors.size() && 1 < this->m_mirrors.size(); ++i) {
+                    if (i == this->m_current) continue;
+                    if (MirrorSet::None == next || this->m_mirrors[i].nextProbe < this->m_mirrors[next].nextProbe)
+                        next = i;
+                }
+                return next;
+            };
+
+            const auto generation = this->m_generation;
+            index = due();
+            if (MirrorSet::None == index) {
+                this->m_wakeup.wait(guard, [this, generation]() {
+                    return true == this->m_stop || generation != this->m_generation;
+                });
+            } else {
+                this->m_wakeup.wait_until(guard, this->m_mirrors[index].nextProbe, [this, generation]() {
+                    return true == this->m_stop || generation != this->m_generation;
+                });
+            }
+            if (true == this->m_stop) break;
+
+            // reconfigurations and failovers change the schedule
+            index = due();
+            if (MirrorSet::None == index || this->m_mirrors[index].nextProbe > std::chrono::steady_clock::now())
+                continue;
+
+            auto &mirror = this->m_mirrors[index];
+            const auto interval = true == mirror.healthy ? __idleProbeInterval : __failedProbeInterval;
+            mirror.nextProbe = std::chrono::steady_clock::now() + interval;
+            url = mirror.url;
+        }
+
+        if (nullptr != socket) this->probe(socket, index, url);
+    }
+
+    if (nullptr != socket) curl_easy_cleanup(socket);
+}
+
+void MirrorSet::probe(CURL *socket, std::size_t index, const std::string &url) {
+    std::uint64_t generation = 0;
+    {
+        std::lock_guard guard(this->m_lock);
+        generation = this->m_generation;
+    }
+
+    const auto endpoint = url + "/api/v1/version";
+    curl_easy_setopt(socket, CURLOPT_URL, endpoint.c_str());
+    const auto result = curl_easy_perform(socket);
+
+    long responseCode = 0;
+    curl_off_t totalTime = 0;
+    if (CURLE_OK == result) {
+        curl_easy_getinfo(socket, CURLINFO_RESPONSE_CODE, &responseCode);
+        curl_easy_getinfo(socket, CURLINFO_TOTAL_TIME_T, &totalTime);
+    }
+
+    {
+        // the mirrors were replaced while the probe was running
+        std::lock_guard guard(this->m_lock);
+        if (generation != this->m_generation) return;
+    }
+
+    if (CURLE_OK != result || responseCode >= 500 || 429 == responseCode)
+        this->recordFailure(index);
+    else
+        this->recordSuccess(index, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::microseconds(totalTime)));
+}
+
+std::vector<std::string> MirrorSet::status() {
+    std::lock_guard guard(this->m_lock);
+
+    std::vector<std::string> status;
+    for (std::size_t i = 0; i < this->m_mirrors.size(); ++i) {
+        const auto &mirror = this->m_mirrors[i];
+
+        std::string latency = "no latencies";
+        if (0 != mirror.samples)
+            latency = "p50 " + std::to_string(MirrorSet::percentile(mirror, 50).count()) + " ms, p95 " +
+                      std::to_string(MirrorSet::percentile(mirror, 95).count()) + " ms";
+
+        status.push_back("Mirror " + mirror.url + ": " + (i == this->m_current ? "current, " : "") +
+                         (true == mirror.healthy ? "healthy" : "down") + ", " + latency + ", " +
+                         std::to_string(mirror.failures) + " of " + std::to_string(mirror.requests) +
+                         " requests failed");
+    }
+
+    return status;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#define CURL_STATICLIB 1
+#include <curl/curl.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vacdm::com {
+/// @brief the base urls of the backend mirrors with their latency statistics
+/// @details The requests stick to the current mirror until it fails repeatedly or the hedges to another mirror keep
+/// winning. Failed mirrors are probed on an own thread and rejoin once they answer, the other mirrors are probed as
+/// well to keep their latencies up to date.
+class MirrorSet {
+   public:
+    static constexpr std::size_t None = std::numeric_limits<std::size_t>::max();
+
+   private:
+    static constexpr std::size_t LatencySamples = 64;
+
+    struct Mirror {
+        std::string url;
+        bool healthy = true;
+        std::uint32_t consecutiveFailures = 0;
+        /// @brief hedges which answered before the current mirror since it answered first the last time
+        std::uint32_t hedgeWins = 0;
+        std::uint64_t requests = 0;
+        std::uint64_t failures = 0;
+        /// @brief ring buffer of the latencies of the answered requests in milliseconds
+        std::array<std::uint32_t, LatencySamples> latencies{};
+        std::size_t samples = 0;
+        std::chrono::steady_clock::time_point nextProbe;
+    };
+
+    std::thread m_thread;
+    std::mutex m_lock;
+    std::condition_variable m_wakeup;
+    bool m_stop;
+    /// @brief incremented by every reconfiguration, the results of running probes are dropped if it does not match
+    std::uint64_t m_generation;
+    std::vector<Mirror> m_mirrors;
+    std::size_t m_current;
+
+    void run();
+    /// @brief requests the version endpoint of the mirror, the result is recorded like a regular request
+    void probe(CURL *socket, std::size_t index, const std::string &url);
+    /// @brief returns the percentile of the latencies, requires m_lock
+    static std::chrono::milliseconds percentile(const Mirror &mirror, std::size_t percent);
+    /// @brief returns the healthy mirror with the lowest median latency besides the current one, requires m_lock
+    std::size_t fastestAlternative() const;
+    /// @brief makes the mirror the current one, requires m_lock
+    void select(std::size_t index, const std::string &reason);
+
+   public:
+    MirrorSet();
+    ~MirrorSet();
+    MirrorSet(const MirrorSet &) = delete;
+    MirrorSet(MirrorSet &&) = delete;
+    MirrorSet &operator=(const MirrorSet &) = delete;
+    MirrorSet &operator=(MirrorSet &&) = delete;
+
+    /// @brief replaces the mirrors and resets their statistics, the first url is used until it fails
+    void setUrls(const std::vector<std::string> &urls);
+    /// @brief returns the index of the mirror which receives the requests
+    std::size_t current();
+    std::string url(std::size_t index);
+    /// @brief returns the healthy mirror with the lowest median latency besides the current one, None if there is none
+    std::size_t hedgeTarget();
+    /// @brief returns the time after which an unanswered request to the current mirror is hedged, its p95 latency
+    std::chrono::milliseconds hedgeDelay();
+    void recordSuccess(std::size_t index, std::chrono::milliseconds latency);
+    void recordFailure(std::size_t index);
+    /// @brief records a hedge to the mirror which answered before the current mirror
+    void recordHedgeWin(std::size_t index);
+    /// @brief returns the state of every mirror as human readable messages
+    std::vector<std::string> status();
+};
+}  // namespace vacdm::com
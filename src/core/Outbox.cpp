@@ -0,0 +1,254 @@
+#include "Outbox.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include <json/json.h>
+
+using namespace vacdm::com;
+
+static constexpr char __fileMagic[8] = {'V', 'A', 'C', 'D', 'M', 'O', 'B', 'X'};
+static constexpr std::uint32_t __fileVersion = 1;
+static constexpr std::uint64_t __headerSize = sizeof(__fileMagic) + sizeof(__fileVersion);
+
+static constexpr std::uint8_t __writeRecord = 1;
+static constexpr std::uint8_t __acknowledgeRecord = 2;
+
+// acknowledgements are appended, the file is trimmed to the pending writes once it exceeds this size
+static constexpr std::uint64_t __compactionSize = 1024ull * 1024ull;
+
+template <typename T>
+static void __append(std::string &buffer, T value) {
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static void __append(std::string &buffer, const std::string &value) {
+    __append(buffer, static_cast<std::uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+template <typename T>
+static bool __read(const std::string &buffer, std::size_t &offset, T &value) {
+    if (buffer.size() - offset < sizeof(value)) return false;
+    std::memcpy(&value, buffer.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return true;
+}
+
+static bool __read(const std::string &buffer, std::size_t &offset, std::string &value) {
+    std::uint32_t length = 0;
+    if (false == __read(buffer, offset, length) || buffer.size() - offset < length) return false;
+    value.assign(buffer.data() + offset, length);
+    offset += length;
+    return true;
+}
+
+// merges the members of a later patch into an earlier one, the later values win
+static void __merge(Json::Value &target, const Json::Value &source) {
+    for (const auto &name : source.getMemberNames()) {
+        if (true == target[name].isObject() && true == source[name].isObject())
+            __merge(target[name], source[name]);
+        else
+            target[name] = source[name];
+    }
+}
+
+Outbox::Outbox() : m_lock(), m_filename(), m_file(), m_fileSize(0), m_nextSequence(1), m_writes() {}
+
+void Outbox::open(const std::string &filename) {
+    std::lock_guard guard(this->m_lock);
+
+    if (true == this->m_file.is_open()) this->m_file.close();
+    this->m_filename = filename;
+
+    this->load();
+    this->compact();
+}
+
+void Outbox::load() {
+    std::ifstream stream(this->m_filename, std::ios::binary);
+    if (false == stream.is_open()) return;
+
+    const std::string buffer((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    if (buffer.size() < __headerSize || 0 != std::memcmp(buffer.data(), __fileMagic, sizeof(__fileMagic))) return;
+
+    std::size_t offset = sizeof(__fileMagic);
+    std::uint32_t version = 0;
+    if (false == __read(buffer, offset, version) || __fileVersion != version) return;
+
+    // a record which was not written completely ends the journal
+    while (offset < buffer.size()) {
+        std::uint32_t length = 0;
+        if (false == __read(buffer, offset, length) || buffer.size() - offset < length) break;
+
+        const std::string record = buffer.substr(offset, length);
+        offset += length;
+
+        std::size_t recordOffset = 0;
+        std::uint8_t type = 0;
+        std::uint64_t sequence = 0;
+        if (false == __read(record, recordOffset, type) || false == __read(record, recordOffset, sequence)) break;
+        this->m_nextSequence = std::max(this->m_nextSequence, sequence + 1);
+
+        if (__acknowledgeRecord == type) {
+            this->m_writes.remove_if([sequence](const Write &write) { return sequence == write.sequence; });
+        } else if (__writeRecord == type) {
+            Write write{sequence, Method::Patch, {}, {}, {}};
+            std::uint8_t method = 0;
+            if (false == __read(record, recordOffset, method) ||
+                false == __read(record, recordOffset, write.callsign) ||
+                false == __read(record, recordOffset, write.endpoint) ||
+                false == __read(record, recordOffset, write.body))
+                break;
+            write.method = static_cast<Method>(method);
+            this->m_writes.push_back(std::move(write));
+        }
+    }
+}
+
+void Outbox::compact() {
+    if (true == this->m_filename.empty()) return;
+
+    if (true == this->m_file.is_open()) this->m_file.close();
+
+    // write the pending writes to a new file and replace the journal by it
+    const auto temporary = this->m_filename + ".tmp";
+    this->m_file.open(temporary, std::ios::binary | std::ios::trunc);
+    if (false == this->m_file.is_open()) return;
+
+    this->m_file.write(__fileMagic, sizeof(__fileMagic));
+    this->m_file.write(reinterpret_cast<const char *>(&__fileVersion), sizeof(__fileVersion));
+    this->m_fileSize = __headerSize;
+    for (const auto &write : std::as_const(this->m_writes)) this->writeRecord(__writeRecord, write.sequence, &write);
+    this->m_file.close();
+
+    std::error_code error;
+    std::filesystem::rename(temporary, this->m_filename, error);
+    if (error) return;
+
+    this->m_file.open(this->m_filename, std::ios::binary | std::ios::app);
+}
+
+void Outbox::truncate() {
+    if (true == this->m_filename.empty()) return;
+
+    // nothing is pending, a journal which is cut off before the header is loaded as empty journal as well
+    if (true == this->m_file.is_open()) this->m_file.close();
+    this->m_file.open(this->m_filename, std::ios::binary | std::ios::trunc);
+    if (false == this->m_file.is_open()) return;
+
+    this->m_file.write(__fileMagic, sizeof(__fileMagic));
+    this->m_file.write(reinterpret_cast<const char *>(&__fileVersion), sizeof(__fileVersion));
+    this->m_file.flush();
+    this->m_fileSize = __headerSize;
+}
+
+void Outbox::writeRecord(std::uint8_t type, std::uint64_t sequence, const Write *write) {
+    if (false == this->m_file.is_open()) return;
+
+    std::string record;
+    __append(record, type);
+    __append(record, sequence);
+    if (nullptr != write) {
+        __append(record, static_cast<std::uint8_t>(write->method));
+        __append(record, write->callsign);
+        __append(record, write->endpoint);
+        __append(record, write->body);
+    }
+
+    std::string buffer;
+    __append(buffer, static_cast<std::uint32_t>(record.size()));
+    buffer.append(record);
+
+    // flushed per record, the OS writes the data back even if EuroScope terminates afterwards
+    this->m_file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    this->m_file.flush();
+    this->m_fileSize += buffer.size();
+}
+
+void Outbox::append(Method method, const std::string &callsign, const std::string &endpoint,
+                    const std::string &body) {
+    std::lock_guard guard(this->m_lock);
+
+    this->m_writes.push_back({this->m_nextSequence++, method, callsign, endpoint, body});
+    this->writeRecord(__writeRecord, this->m_writes.back().sequence, &this->m_writes.back());
+}
+
+void Outbox::acknowledge(const std::vector<std::uint64_t> &sequences) {
+    std::lock_guard guard(this->m_lock);
+
+    this->m_writes.remove_if([&sequences](const Write &write) {
+        return sequences.cend() != std::find(sequences.cbegin(), sequences.cend(), write.sequence);
+    });
+
+    for (const auto sequence : sequences) this->writeRecord(__acknowledgeRecord, sequence, nullptr);
+    if (this->m_fileSize < __compactionSize) return;
+
+    if (true == this->m_writes.empty())
+        this->truncate();
+    else
+        this->compact();
+}
+
+std::vector<Outbox::Entry> Outbox::pending() {
+    std::lock_guard guard(this->m_lock);
+
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> lastEntries;
+
+    for (const auto &write : std::as_const(this->m_writes)) {
+        auto last = lastEntries.find(write.callsign);
+
+        if (Method::Delete == write.method && lastEntries.end() != last) {
+            // the pilot is deleted, the earlier writes are acknowledged together with the delete
+            std::vector<std::uint64_t> sequences;
+            for (auto it = entries.begin(); it != entries.end();) {
+                if (write.callsign == it->callsign) {
+                    sequences.insert(sequences.end(), it->sequences.cbegin(), it->sequences.cend());
+                    it = entries.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            sequences.push_back(write.sequence);
+            entries.push_back({std::move(sequences), write.method, write.callsign, write.endpoint, write.body});
+            last->second = std::prev(entries.end());
+            continue;
+        }
+
+        if (Method::Patch == write.method && lastEntries.end() != last && Method::Patch == last->second->method &&
+            write.endpoint == last->second->endpoint) {
+            Json::CharReaderBuilder builder{};
+            const auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
+            Json::Value merged, patch;
+            const auto &previous = last->second->body;
+            if (true == reader->parse(previous.c_str(), previous.c_str() + previous.length(), &merged, nullptr) &&
+                true == reader->parse(write.body.c_str(), write.body.c_str() + write.body.length(), &patch,
+                                      nullptr) &&
+                true == merged.isObject() && true == patch.isObject()) {
+                __merge(merged, patch);
+
+                Json::StreamWriterBuilder writer{};
+                writer["indentation"] = "";
+                last->second->body = Json::writeString(writer, merged);
+                last->second->sequences.push_back(write.sequence);
+                continue;
+            }
+        }
+
+        entries.push_back({{write.sequence}, write.method, write.callsign, write.endpoint, write.body});
+        lastEntries[write.callsign] = std::prev(entries.end());
+    }
+
+    return std::vector<Entry>(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+}
+
+std::size_t Outbox::size() {
+    std::lock_guard guard(this->m_lock);
+    return this->m_writes.size();
+}
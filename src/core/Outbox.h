@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace vacdm::com {
+/// @brief write-ahead journal of the requests which change the backend data
+/// @details Every write is appended to a length-prefixed file before it is sent and acknowledged after the backend
+/// answered. The writes which are not acknowledged survive outages and restarts and are replayed in order.
+class Outbox {
+   public:
+    enum class Method : std::uint8_t { Post = 1, Patch = 2, Delete = 3 };
+
+    /// @brief a pending request, coalesced entries acknowledge all journaled writes they replace
+    struct Entry {
+        std::vector<std::uint64_t> sequences;
+        Method method = Method::Patch;
+        std::string callsign;
+        std::string endpoint;
+        std::string body;
+    };
+
+   private:
+    struct Write {
+        std::uint64_t sequence;
+        Method method;
+        std::string callsign;
+        std::string endpoint;
+        std::string body;
+    };
+
+    std::mutex m_lock;
+    std::string m_filename;
+    std::ofstream m_file;
+    std::uint64_t m_fileSize;
+    std::uint64_t m_nextSequence;
+    std::list<Write> m_writes;
+
+    void load();
+    /// @brief replaces the journal by a file which only contains the pending writes
+    void compact();
+    /// @brief truncates the journal in place to the header, requires that no write is pending
+    void truncate();
+    void writeRecord(std::uint8_t type, std::uint64_t sequence, const Write *write);
+
+   public:
+    Outbox();
+    Outbox(const Outbox &) = delete;
+    Outbox(Outbox &&) = delete;
+    Outbox &operator=(const Outbox &) = delete;
+    Outbox &operator=(Outbox &&) = delete;
+
+    /// @brief opens the journal file, the pending writes of the last session are restored
+    void open(const std::string &filename);
+    /// @brief journals a write, it is kept in memory only if the journal is not opened
+    void append(Method method, const std::string &callsign, const std::string &endpoint, const std::string &body);
+    /// @brief marks the journaled writes as delivered, the file is trimmed once it exceeds the compaction size
+    void acknowledge(const std::vector<std::uint64_t> &sequences);
+    /// @brief returns the pending writes in order
+    /// @details The writes are coalesced per callsign, consecutive patches of an endpoint are merged and a delete
+    /// replaces the earlier writes of the callsign.
+    std::vector<Entry> pending();
+    std::size_t size();
+};
+}  // namespace vacdm::com
@@ -0,0 +1,84 @@
+#include "PatchBody.h"
+
+#include <format>
+#include <iterator>
+
+#include "utils/Date.h"
+
+using namespace vacdm::com;
+
+static constexpr std::string_view __bodyBegin = "{\"callsign\":";
+static constexpr std::string_view __vacdmBegin = ",\"vacdm\":{";
+static constexpr std::string_view __bodyEnd = "}}";
+
+static std::string &__threadBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
+
+PatchBody::PatchBody(std::string_view callsign) : m_buffer(__threadBuffer()), m_firstField(true) {
+    this->m_buffer.clear();
+    this->m_buffer.append(__bodyBegin);
+    this->appendString(callsign);
+    this->m_buffer.append(__vacdmBegin);
+}
+
+void PatchBody::appendKey(const Key &key) {
+    if (false == this->m_firstField) this->m_buffer.push_back(',');
+    this->m_firstField = false;
+    this->m_buffer.append(key.token);
+}
+
+void PatchBody::appendString(std::string_view value) {
+    this->m_buffer.push_back('"');
+    for (const auto c : value) {
+        if ('"' == c || '\\' == c) {
+            this->m_buffer.push_back('\\');
+            this->m_buffer.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::format_to(std::back_inserter(this->m_buffer), "\\u{:04x}", static_cast<unsigned int>(c));
+        } else {
+            this->m_buffer.push_back(c);
+        }
+    }
+    this->m_buffer.push_back('"');
+}
+
+PatchBody &PatchBody::time(const Key &key, const std::chrono::utc_clock::time_point &value) {
+    if (value.time_since_epoch().count() < 0) return this->reset(key);
+
+    this->appendKey(key);
+    this->m_buffer.push_back('"');
+    // same format as utils::Date::timestampToIsoString without the temporary strings
+    const auto seconds = std::chrono::floor<std::chrono::seconds>(value);
+    std::format_to(std::back_inserter(this->m_buffer), "{0:%FT%T}.{1:03}Z", seconds,
+                   std::chrono::duration_cast<std::chrono::milliseconds>(value - seconds).count());
+    this->m_buffer.push_back('"');
+    return *this;
+}
+
+PatchBody &PatchBody::reset(const Key &key) {
+    this->appendKey(key);
+    this->m_buffer.push_back('"');
+    this->m_buffer.append(utils::Date::ResetTimestamp);
+    this->m_buffer.push_back('"');
+    return *this;
+}
+
+PatchBody &PatchBody::string(const Key &key, std::string_view value) {
+    this->appendKey(key);
+    this->appendString(value);
+    return *this;
+}
+
+PatchBody &PatchBody::minutes(const Key &key, const std::chrono::utc_clock::time_point &value) {
+    this->appendKey(key);
+    this->m_buffer.append(
+        std::to_string(std::chrono::duration_cast<std::chrono::minutes>(value.time_since_epoch()).count()));
+    return *this;
+}
+
+const std::string &PatchBody::finish() {
+    this->m_buffer.append(__bodyEnd);
+    return this->m_buffer;
+}
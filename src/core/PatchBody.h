@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace vacdm::com {
+/// @brief writes the compact JSON body of a pilot patch without building a Json::Value
+/// @details The body has the fixed layout {"callsign":"...","vacdm":{...}}. The keys are pre-serialized tokens and
+/// the values are appended to a buffer which is reused by all bodies written on the same thread.
+class PatchBody {
+   public:
+    /// @brief pre-serialized key of a field in the vacdm object
+    struct Key {
+        std::string_view token;
+    };
+
+    static constexpr Key Exot{"\"exot\":"};
+    static constexpr Key Tobt{"\"tobt\":"};
+    static constexpr Key TobtState{"\"tobt_state\":"};
+    static constexpr Key Tsat{"\"tsat\":"};
+    static constexpr Key Ttot{"\"ttot\":"};
+    static constexpr Key Asat{"\"asat\":"};
+    static constexpr Key Asrt{"\"asrt\":"};
+    static constexpr Key Aobt{"\"aobt\":"};
+    static constexpr Key Aort{"\"aort\":"};
+    static constexpr Key Atot{"\"atot\":"};
+
+   private:
+    std::string &m_buffer;
+    bool m_firstField;
+
+    void appendKey(const Key &key);
+    void appendString(std::string_view value);
+
+   public:
+    explicit PatchBody(std::string_view callsign);
+    PatchBody(const PatchBody &) = delete;
+    PatchBody(PatchBody &&) = delete;
+    PatchBody &operator=(const PatchBody &) = delete;
+    PatchBody &operator=(PatchBody &&) = delete;
+
+    /// @brief writes an ISO timestamp, times before the epoch are written as the reset sentinel
+    PatchBody &time(const Key &key, const std::chrono::utc_clock::time_point &value);
+    /// @brief writes the reset sentinel which clears the timestamp in the backend
+    PatchBody &reset(const Key &key);
+    PatchBody &string(const Key &key, std::string_view value);
+    /// @brief writes the time since the epoch in minutes
+    PatchBody &minutes(const Key &key, const std::chrono::utc_clock::time_point &value);
+
+    /// @brief closes the body and returns it, the buffer is overwritten by the next body on the same thread
+    const std::string &finish();
+};
+}  // namespace vacdm::com
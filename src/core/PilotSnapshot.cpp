@@ -0,0 +1,192 @@
+#include "PilotSnapshot.h"
+
+#include <Windows.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace vacdm::core;
+
+static std::int64_t __toSeconds(const std::chrono::utc_clock::time_point &value) {
+    if (vacdm::types::defaultTime == value) return snapshot::UnsetTime;
+    return std::chrono::floor<std::chrono::seconds>(value.time_since_epoch()).count();
+}
+
+static std::chrono::utc_clock::time_point __fromSeconds(std::int64_t value) {
+    if (snapshot::UnsetTime == value) return vacdm::types::defaultTime;
+    return std::chrono::utc_clock::time_point(std::chrono::seconds(value));
+}
+
+static std::int64_t &__time(snapshot::PilotEntry &entry, snapshot::Time time) {
+    return entry.times[static_cast<std::size_t>(time)];
+}
+
+static std::int64_t __time(const snapshot::PilotEntry &entry, snapshot::Time time) {
+    return entry.times[static_cast<std::size_t>(time)];
+}
+
+bool PilotSnapshot::save(const std::string &filename, const std::vector<types::PilotRecord> &pilots) {
+    std::vector<snapshot::PilotEntry> entries;
+    std::vector<snapshot::MeasureEntry> measures;
+    entries.reserve(pilots.size());
+
+    for (const auto &pilot : pilots) {
+        snapshot::PilotEntry entry{};
+        entry.callsign = pilot.callsign;
+        entry.euroscope = pilot.euroscope;
+        entry.server = pilot.server;
+
+        const auto &acdm = pilot.acdm;
+        __time(entry, snapshot::Time::LastUpdate) = __toSeconds(acdm.lastUpdate.get());
+        __time(entry, snapshot::Time::Eobt) = __toSeconds(acdm.eobt.get());
+        __time(entry, snapshot::Time::Tobt) = __toSeconds(acdm.tobt.get());
+        __time(entry, snapshot::Time::Ctot) = __toSeconds(acdm.ctot.get());
+        __time(entry, snapshot::Time::Ttot) = __toSeconds(acdm.ttot.get());
+        __time(entry, snapshot::Time::Tsat) = __toSeconds(acdm.tsat.get());
+        __time(entry, snapshot::Time::Asat) = __toSeconds(acdm.asat.get());
+        __time(entry, snapshot::Time::Aobt) = __toSeconds(acdm.aobt.get());
+        __time(entry, snapshot::Time::Atot) = __toSeconds(acdm.atot.get());
+        __time(entry, snapshot::Time::Asrt) = __toSeconds(acdm.asrt.get());
+        __time(entry, snapshot::Time::Aort) = __toSeconds(acdm.aort.get());
+        __time(entry, snapshot::Time::Exot) = __toSeconds(acdm.exot.get());
+        entry.tobtState = acdm.tobtState;
+        entry.hasServerData = true == pilot.hasServerData ? 1 : 0;
+        entry.hasBooking = true == acdm.hasBooking ? 1 : 0;
+        entry.taxizoneIsTaxiout = true == acdm.taxizoneIsTaxiout ? 1 : 0;
+
+        entry.firstMeasure = static_cast<std::uint32_t>(measures.size());
+        entry.measureCount = static_cast<std::uint32_t>(pilot.measures.size());
+        for (const auto &measure : pilot.measures) {
+            snapshot::MeasureEntry measureEntry{};
+            measureEntry.ident.assign(measure.ident);
+            measureEntry.value = measure.value;
+            measures.push_back(measureEntry);
+        }
+
+        entries.push_back(entry);
+    }
+
+    snapshot::FileHeader header{};
+    std::memcpy(header.magic, snapshot::FileMagic, sizeof(header.magic));
+    header.version = snapshot::FileVersion;
+    header.headerSize = sizeof(snapshot::FileHeader);
+    header.savedAt = __toSeconds(std::chrono::utc_clock::now());
+    header.pilotCount = static_cast<std::uint32_t>(entries.size());
+    header.measureCount = static_cast<std::uint32_t>(measures.size());
+    header.pilotEntrySize = sizeof(snapshot::PilotEntry);
+    header.measureEntrySize = sizeof(snapshot::MeasureEntry);
+
+    // the snapshot is replaced as a whole, a crash while writing keeps the previous one
+    const auto temporary = filename + ".tmp";
+    {
+        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+        if (false == stream.is_open()) return false;
+
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char *>(entries.data()),
+                     static_cast<std::streamsize>(entries.size() * sizeof(snapshot::PilotEntry)));
+        stream.write(reinterpret_cast<const char *>(measures.data()),
+                     static_cast<std::streamsize>(measures.size() * sizeof(snapshot::MeasureEntry)));
+        if (false == stream.good()) return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    return !error;
+}
+
+std::vector<vacdm::types::PilotRecord> PilotSnapshot::load(const std::string &filename,
+                                                           std::chrono::seconds maximumAge) {
+    const auto file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file) return {};
+
+    LARGE_INTEGER fileSize;
+    if (FALSE == GetFileSizeEx(file, &fileSize) ||
+        fileSize.QuadPart < static_cast<LONGLONG>(sizeof(snapshot::FileHeader))) {
+        CloseHandle(file);
+        return {};
+    }
+
+    const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const auto view = nullptr != mapping ? static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0))
+                                         : nullptr;
+
+    std::vector<types::PilotRecord> pilots;
+    if (nullptr != view) {
+        const auto size = static_cast<std::uint64_t>(fileSize.QuadPart);
+
+        snapshot::FileHeader header;
+        std::memcpy(&header, view, sizeof(header));
+
+        const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::utc_clock::now().time_since_epoch());
+        const auto expectedSize = static_cast<std::uint64_t>(header.headerSize) +
+                                  static_cast<std::uint64_t>(header.pilotCount) * sizeof(snapshot::PilotEntry) +
+                                  static_cast<std::uint64_t>(header.measureCount) * sizeof(snapshot::MeasureEntry);
+        const auto valid = 0 == std::memcmp(header.magic, snapshot::FileMagic, sizeof(header.magic)) &&
+                           snapshot::FileVersion == header.version &&
+                           sizeof(snapshot::FileHeader) == header.headerSize &&
+                           sizeof(snapshot::PilotEntry) == header.pilotEntrySize &&
+                           sizeof(snapshot::MeasureEntry) == header.measureEntrySize && expectedSize <= size &&
+                           now.count() - header.savedAt <= maximumAge.count();
+
+        if (true == valid) {
+            const auto entries = view + header.headerSize;
+            const auto measures =
+                entries + static_cast<std::uint64_t>(header.pilotCount) * sizeof(snapshot::PilotEntry);
+
+            pilots.reserve(header.pilotCount);
+            for (std::uint32_t i = 0; i < header.pilotCount; ++i) {
+                // the view is only aligned to the page, copy the entry instead of casting
+                snapshot::PilotEntry entry;
+                std::memcpy(&entry, entries + i * sizeof(snapshot::PilotEntry), sizeof(entry));
+                if (static_cast<std::uint64_t>(entry.firstMeasure) + entry.measureCount > header.measureCount) continue;
+
+                types::PilotRecord pilot;
+                pilot.callsign = entry.callsign;
+                pilot.euroscope = entry.euroscope;
+                pilot.server = entry.server;
+                pilot.hasServerData = 0 != entry.hasServerData;
+
+                auto &acdm = pilot.acdm;
+                acdm.lastUpdate = __fromSeconds(__time(entry, snapshot::Time::LastUpdate));
+                acdm.eobt = __fromSeconds(__time(entry, snapshot::Time::Eobt));
+                acdm.tobt = __fromSeconds(__time(entry, snapshot::Time::Tobt));
+                acdm.ctot = __fromSeconds(__time(entry, snapshot::Time::Ctot));
+                acdm.ttot = __fromSeconds(__time(entry, snapshot::Time::Ttot));
+                acdm.tsat = __fromSeconds(__time(entry, snapshot::Time::Tsat));
+                acdm.asat = __fromSeconds(__time(entry, snapshot::Time::Asat));
+                acdm.aobt = __fromSeconds(__time(entry, snapshot::Time::Aobt));
+                acdm.atot = __fromSeconds(__time(entry, snapshot::Time::Atot));
+                acdm.asrt = __fromSeconds(__time(entry, snapshot::Time::Asrt));
+                acdm.aort = __fromSeconds(__time(entry, snapshot::Time::Aort));
+                acdm.exot = __fromSeconds(__time(entry, snapshot::Time::Exot));
+                acdm.tobtState = entry.tobtState;
+                acdm.hasBooking = 0 != entry.hasBooking;
+                acdm.taxizoneIsTaxiout = 0 != entry.taxizoneIsTaxiout;
+
+                for (std::uint32_t m = 0; m < entry.measureCount; ++m) {
+                    snapshot::MeasureEntry measureEntry;
+                    const auto offset =
+                        (static_cast<std::uint64_t>(entry.firstMeasure) + m) * sizeof(snapshot::MeasureEntry);
+                    std::memcpy(&measureEntry, measures + offset, sizeof(measureEntry));
+
+                    types::EcfmpMeasure measure;
+                    measure.ident = measureEntry.ident.str();
+                    measure.value = measureEntry.value;
+                    pilot.measures.push_back(std::move(measure));
+                }
+
+                pilots.push_back(std::move(pilot));
+            }
+        }
+
+        UnmapViewOfFile(view);
+    }
+
+    if (nullptr != mapping) CloseHandle(mapping);
+    CloseHandle(file);
+
+    return pilots;
+}
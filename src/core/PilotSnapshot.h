@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "types/PilotRecord.h"
+
+namespace vacdm::core {
+namespace snapshot {
+// Layout of the pilot snapshot (vacdm_snapshot.bin), written and read by the same plugin build.
+//
+// The file starts with a FileHeader, followed by pilotCount PilotEntry and measureCount MeasureEntry. The entries are
+// fixed-size and read in place from the mapped file. The timestamps are seconds since the UNIX epoch, unset times
+// are stored as UnsetTime.
+
+static constexpr char FileMagic[8] = {'V', 'A', 'C', 'D', 'M', 'S', 'N', 'P'};
+static constexpr std::uint32_t FileVersion = 1;
+static constexpr std::int64_t UnsetTime = std::numeric_limits<std::int64_t>::min();
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    /// @brief seconds since the UNIX epoch
+    std::int64_t savedAt;
+    std::uint32_t pilotCount;
+    std::uint32_t measureCount;
+    /// @brief sizes of the entries, a build with a different layout ignores the file
+    std::uint32_t pilotEntrySize;
+    std::uint32_t measureEntrySize;
+};
+
+enum class Time : std::uint8_t { LastUpdate, Eobt, Tobt, Ctot, Ttot, Tsat, Asat, Aobt, Atot, Asrt, Aort, Exot, Count };
+
+struct PilotEntry {
+    types::FixedString<16> callsign;
+    types::FlightplanData euroscope;
+    types::FlightplanData server;
+    std::int64_t times[static_cast<std::size_t>(Time::Count)];
+    types::FixedString<12> tobtState;
+    std::uint8_t hasServerData;
+    std::uint8_t hasBooking;
+    std::uint8_t taxizoneIsTaxiout;
+    std::uint32_t firstMeasure;
+    std::uint32_t measureCount;
+};
+
+struct MeasureEntry {
+    types::FixedString<16> ident;
+    std::int64_t value;
+};
+
+static_assert(sizeof(FileHeader) == 40);
+}  // namespace snapshot
+
+/// @brief binary snapshot of the consolidated pilot data, used to warm-start the DataManager
+class PilotSnapshot {
+   public:
+    /// @brief writes the pilots to a temporary file and replaces the snapshot by it
+    /// @return true if the snapshot was written
+    static bool save(const std::string &filename, const std::vector<types::PilotRecord> &pilots);
+    /// @brief maps the snapshot and restores the pilots
+    /// @param maximumAge snapshots which are older are ignored
+    /// @return the pilots or an empty list if the file is missing, outdated or invalid
+    static std::vector<types::PilotRecord> load(const std::string &filename, std::chrono::seconds maximumAge);
+};
+}  // namespace vacdm::core
@@ -0,0 +1,338 @@
+#include "PushChannel.h"
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <numeric>
+
+#include <json/json.h>
+
+#include "log/Logger.h"
+#include "types/PilotJson.h"
+
+using namespace vacdm::com;
+using namespace vacdm::logging;
+using namespace std::chrono_literals;
+
+static const Logger::LogLimit __streamLogLimit{60s, 1};
+
+// the reconnect delay doubles after every failed attempt, an established stream resets it
+static constexpr auto __initialReconnectDelay = std::chrono::milliseconds(1000);
+static constexpr auto __maximumReconnectDelay = std::chrono::milliseconds(60000);
+// the backend sends comments as keep-alive, a stream without any data in this time is considered dead
+static constexpr long __stallSeconds = 90;
+// protects against streams which never finish a line
+static constexpr std::size_t __maximumLineLength = 1024 * 1024;
+
+PushChannel::PushChannel()
+    : m_thread(),
+      m_lock(),
+      m_wakeup(),
+      m_url(),
+      m_airports(),
+      m_generation(0),
+      m_stop(false),
+      m_pilots(),
+      m_lastEventId(),
+      m_receivedEvents(0),
+      m_rejectedEvents(0),
+      m_lastError(),
+      m_connected(false),
+      m_sessions(0) {
+    this->m_thread = std::thread(&PushChannel::run, this);
+}
+
+PushChannel::~PushChannel() {
+    {
+        std::lock_guard guard(this->m_lock);
+        this->m_stop = true;
+    }
+    this->m_wakeup.notify_all();
+    this->m_thread.join();
+}
+
+void PushChannel::setUrl(const std::string &url) {
+    {
+        std::lock_guard guard(this->m_lock);
+        if (url == this->m_url) return;
+
+        this->m_url = url;
+        this->m_generation += 1;
+    }
+    this->m_wakeup.notify_all();
+}
+
+void PushChannel::setAirports(const std::list<std::string> &airports) {
+    {
+        std::lock_guard guard(this->m_lock);
+        if (airports == this->m_airports) return;
+
+        this->m_airports = airports;
+        this->m_generation += 1;
+    }
+    this->m_wakeup.notify_all();
+}
+
+bool PushChannel::connected() const { return this->m_connected.load(); }
+
+std::uint64_t PushChannel::sessions() const { return this->m_sessions.load(); }
+
+std::vector<vacdm::types::Pilot> PushChannel::takePilots() {
+    std::lock_guard guard(this->m_lock);
+
+    std::vector<types::Pilot> pilots;
+    std::swap(pilots, this->m_pilots);
+    return pilots;
+}
+
+std::string PushChannel::status() {
+    std::lock_guard guard(this->m_lock);
+
+    if (true == this->m_url.empty()) return "Push channel: disabled";
+
+    std::string status = "Push channel: ";
+    if (true == this->m_connected)
+        status += "connected";
+    else if (true == this->m_airports.empty())
+        status += "waiting for active airports";
+    else
+        status += "connecting";
+
+    status += " (" + std::to_string(this->m_sessions) + " sessions, " + std::to_string(this->m_receivedEvents) +
+              " pilot events, " + std::to_string(this->m_rejectedEvents) + " rejected)";
+    if (false == this->m_connected && false == this->m_lastError.empty())
+        status += ", last error: " + this->m_lastError;
+    return status;
+}
+
+bool PushChannel::cancelled(std::uint64_t generation) {
+    std::lock_guard guard(this->m_lock);
+    return true == this->m_stop || generation != this->m_generation;
+}
+
+void PushChannel::run() {
+    auto delay = __initialReconnectDelay;
+
+    while (true) {
+        std::string url;
+        std::uint64_t generation;
+        {
+            // the stream is scoped to the active airports, without them it would deliver every pilot
+            std::unique_lock guard(this->m_lock);
+            this->m_wakeup.wait(guard, [this]() {
+                return true == this->m_stop || (false == this->m_url.empty() && false == this->m_airports.empty());
+            });
+            if (true == this->m_stop) return;
+
+            url = this->m_url + "?adep=" +
+                  std::accumulate(std::next(this->m_airports.begin()), this->m_airports.end(),
+                                  this->m_airports.front(),
+                                  [](const std::string &acc, const std::string &str) { return acc + "&adep=" + str; });
+            generation = this->m_generation;
+        }
+
+        Stream stream;
+        stream.channel = this;
+        stream.generation = generation;
+        this->receive(url, generation, stream);
+        this->m_connected = false;
+
+        // the server may propose the reconnect delay
+        const auto wait = std::chrono::milliseconds(0) != stream.retry ? stream.retry : delay;
+        delay = true == stream.accepted ? __initialReconnectDelay : std::min(2 * delay, __maximumReconnectDelay);
+
+        std::unique_lock guard(this->m_lock);
+        // a reconfiguration reconnects immediately
+        this->m_wakeup.wait_for(guard, wait, [this, generation]() {
+            return true == this->m_stop || generation != this->m_generation;
+        });
+        if (true == this->m_stop) return;
+    }
+}
+
+void PushChannel::receive(const std::string &url, std::uint64_t generation, Stream &stream) {
+    const auto socket = curl_easy_init();
+    if (nullptr == socket) return;
+    stream.socket = socket;
+
+    std::string lastEventId;
+    {
+        std::lock_guard guard(this->m_lock);
+        lastEventId = this->m_lastEventId;
+    }
+
+    // the server can resume the stream after the last received event
+    struct curl_slist *headers = nullptr;
+    headers = curl_slist_append(headers, "Accept: text/event-stream");
+    headers = curl_slist_append(headers, "Cache-Control: no-cache");
+    if (false == lastEventId.empty()) headers = curl_slist_append(headers, ("Last-Event-ID: " + lastEventId).c_str());
+
+    curl_easy_setopt(socket, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(socket, CURLOPT_SSL_VERIFYPEER, 0L);
+    curl_easy_setopt(socket, CURLOPT_SSL_VERIFYHOST, 0L);
+    curl_easy_setopt(socket, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
+    curl_easy_setopt(socket, CURLOPT_HTTPGET, 1L);
+    curl_easy_setopt(socket, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(socket, CURLOPT_WRITEFUNCTION, PushChannel::receiveCurl);
+    curl_easy_setopt(socket, CURLOPT_WRITEDATA, &stream);
+    curl_easy_setopt(socket, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(socket, CURLOPT_XFERINFOFUNCTION, PushChannel::progressCurl);
+    curl_easy_setopt(socket, CURLOPT_XFERINFODATA, &stream);
+    curl_easy_setopt(socket, CURLOPT_CONNECTTIMEOUT, 5L);
+    curl_easy_setopt(socket, CURLOPT_LOW_SPEED_LIMIT, 1L);
+    curl_easy_setopt(socket, CURLOPT_LOW_SPEED_TIME, __stallSeconds);
+
+    const auto result = curl_easy_perform(socket);
+
+    long responseCode = 0;
+    curl_easy_getinfo(socket, CURLINFO_RESPONSE_CODE, &responseCode);
+    curl_easy_cleanup(socket);
+    curl_slist_free_all(headers);
+
+    if (true == this->cancelled(generation)) return;
+
+    std::string error;
+    if (0 != responseCode && 200 != responseCode)
+        error = "HTTP " + std::to_string(responseCode);
+    else if (CURLE_OK != result)
+        error = curl_easy_strerror(result);
+    else
+        error = "closed by the server";
+
+    {
+        std::lock_guard guard(this->m_lock);
+        this->m_lastError = error;
+    }
+    Logger::instance().logLimited(Logger::LogSender::Server, "PushChannel:closed", __streamLogLimit,
+                                  "Push stream " + url + " ended: " + error, Logger::LogLevel::Warning);
+}
+
+// the stream is accepted once the server answered with a success, before that the body is an error message
+static bool __accept(CURL *socket, bool &accepted) {
+    if (true == accepted) return true;
+
+    long responseCode = 0;
+    curl_easy_getinfo(socket, CURLINFO_RESPONSE_CODE, &responseCode);
+    accepted = 200 == responseCode;
+    return accepted;
+}
+
+std::size_t PushChannel::receiveCurl(char *ptr, std::size_t size, std::size_t nmemb, void *userdata) {
+    auto &stream = *static_cast<Stream *>(userdata);
+    auto &channel = *stream.channel;
+    const auto length = size * nmemb;
+
+    const auto wasAccepted = stream.accepted;
+    // returning less than the length aborts the transfer
+    if (false == __accept(stream.socket, stream.accepted)) return 0;
+    if (false == wasAccepted) channel.established(stream);
+
+    // the chunks are not zero-terminated and may split lines
+    std::string_view chunk(ptr, length);
+    while (false == chunk.empty()) {
+        const auto end = chunk.find('\n');
+        if (std::string_view::npos == end) {
+            stream.line.append(chunk);
+            break;
+        }
+
+        stream.line.append(chunk.substr(0, end));
+        if (false == stream.line.empty() && '\r' == stream.line.back()) stream.line.pop_back();
+        channel.parseLine(stream, stream.line);
+        stream.line.clear();
+        chunk.remove_prefix(end + 1);
+    }
+
+    return stream.line.size() <= __maximumLineLength ? length : 0;
+}
+
+int PushChannel::progressCurl(void *userdata, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+    auto &stream = *static_cast<Stream *>(userdata);
+
+    // the server may keep the stream silent after the headers
+    if (false == stream.accepted && true == __accept(stream.socket, stream.accepted))
+        stream.channel->established(stream);
+
+    return true == stream.channel->cancelled(stream.generation) ? 1 : 0;
+}
+
+void PushChannel::established(const Stream &stream) {
+    this->m_connected = true;
+    this->m_sessions += 1;
+
+    {
+        std::lock_guard guard(this->m_lock);
+        this->m_lastError.clear();
+    }
+    Logger::instance().log(Logger::LogSender::Server,
+                           "Push stream established, session " + std::to_string(this->m_sessions.load()) +
+                               " of generation " + std::to_string(stream.generation),
+                           Logger::LogLevel::Info);
+}
+
+void PushChannel::parseLine(Stream &stream, std::string_view line) {
+    // an empty line finishes the event
+    if (true == line.empty()) {
+        this->dispatch(stream);
+        return;
+    }
+    // comments are used as keep-alive
+    if (':' == line.front()) return;
+
+    std::string_view field = line, value;
+    const auto colon = line.find(':');
+    if (std::string_view::npos != colon) {
+        field = line.substr(0, colon);
+        value = line.substr(colon + 1);
+        if (false == value.empty() && ' ' == value.front()) value.remove_prefix(1);
+    }
+
+    if ("event" == field) {
+        stream.event = value;
+    } else if ("data" == field) {
+        stream.data.append(value);
+        stream.data.push_back('\n');
+    } else if ("id" == field) {
+        if (std::string_view::npos == value.find('\0')) stream.id = value;
+    } else if ("retry" == field) {
+        const auto digits = std::all_of(value.begin(), value.end(),
+                                        [](char c) { return 0 != std::isdigit(static_cast<unsigned char>(c)); });
+        if (false == value.empty() && true == digits && value.size() < 10)
+            stream.retry = std::chrono::milliseconds(std::stoll(std::string(value)));
+    }
+}
+
+void PushChannel::dispatch(Stream &stream) {
+    const auto event = std::move(stream.event);
+    auto data = std::move(stream.data);
+    stream.event.clear();
+    stream.data.clear();
+    if (true == data.empty()) return;
+    data.pop_back();
+
+    bool rejected = false;
+    types::Pilot pilot;
+    if ("pilot" == event) {
+        Json::CharReaderBuilder builder{};
+        auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
+        std::string errors;
+        Json::Value root;
+
+        if (true == reader->parse(data.data(), data.data() + data.size(), &root, &errors) && root.isObject()) {
+            types::parsePilot(root, pilot);
+            types::parseMeasures(root, pilot);
+        }
+        rejected = true == pilot.callsign.empty();
+    }
+
+    std::lock_guard guard(this->m_lock);
+    if (false == stream.id.empty()) this->m_lastEventId = stream.id;
+    if ("pilot" != event) return;
+
+    if (true == rejected) {
+        this->m_rejectedEvents += 1;
+    } else {
+        this->m_receivedEvents += 1;
+        this->m_pilots.push_back(std::move(pilot));
+    }
+}
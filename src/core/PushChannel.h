@@ -0,0 +1,90 @@
+#pragma once
+
+#define CURL_STATICLIB 1
+#include <curl/curl.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "types/Pilot.h"
+
+namespace vacdm::com {
+/// @brief optional server-sent events stream of the pilot changes of the active airports
+/// @details The stream is received on an own thread and reconnects with a backoff after errors. Every "pilot" event
+/// carries the complete pilot object of the REST API, comments and other events are ignored. The received pilots are
+/// collected until the DataManager takes them.
+class PushChannel {
+   private:
+    std::thread m_thread;
+    std::mutex m_lock;
+    std::condition_variable m_wakeup;
+    /// @brief the stream endpoint, the channel is idle while it is empty
+    std::string m_url;
+    std::list<std::string> m_airports;
+    /// @brief incremented by every reconfiguration, the running stream is closed if it does not match
+    std::uint64_t m_generation;
+    bool m_stop;
+    std::vector<types::Pilot> m_pilots;
+    std::string m_lastEventId;
+    std::uint64_t m_receivedEvents;
+    std::uint64_t m_rejectedEvents;
+    std::string m_lastError;
+
+    std::atomic<bool> m_connected;
+    /// @brief number of established streams, events may have been missed between two of them
+    std::atomic<std::uint64_t> m_sessions;
+
+    /// @brief the parser state of the current stream, only used by the stream thread
+    struct Stream {
+        PushChannel *channel = nullptr;
+        CURL *socket = nullptr;
+        std::uint64_t generation = 0;
+        bool accepted = false;
+        std::string line;
+        std::string event;
+        std::string data;
+        std::string id;
+        std::chrono::milliseconds retry = std::chrono::milliseconds(0);
+    };
+
+    void run();
+    /// @brief receives one stream until it is closed, reconfigured or fails
+    void receive(const std::string &url, std::uint64_t generation, Stream &stream);
+    /// @brief marks the stream as established once the server accepted it
+    void established(const Stream &stream);
+    void parseLine(Stream &stream, std::string_view line);
+    void dispatch(Stream &stream);
+    static std::size_t receiveCurl(char *ptr, std::size_t size, std::size_t nmemb, void *userdata);
+    static int progressCurl(void *userdata, curl_off_t, curl_off_t, curl_off_t, curl_off_t);
+    /// @brief checks if the stream thread has to close the stream
+    bool cancelled(std::uint64_t generation);
+
+   public:
+    PushChannel();
+    ~PushChannel();
+    PushChannel(const PushChannel &) = delete;
+    PushChannel(PushChannel &&) = delete;
+    PushChannel &operator=(const PushChannel &) = delete;
+    PushChannel &operator=(PushChannel &&) = delete;
+
+    /// @brief opens the stream of the endpoint, an empty url closes it
+    void setUrl(const std::string &url);
+    /// @brief reopens the stream for the airports, it is scoped to the departures of these airports
+    void setAirports(const std::list<std::string> &airports);
+    /// @brief checks if the stream is established and delivers events
+    bool connected() const;
+    std::uint64_t sessions() const;
+    /// @brief returns the pilots received since the last call, a pilot received twice is returned twice
+    std::vector<types::Pilot> takePilots();
+    /// @brief returns the state of the channel as human readable message
+    std::string status();
+};
+}  // namespace vacdm::com
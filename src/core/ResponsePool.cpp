@@ -0,0 +1,42 @@
+#include "ResponsePool.h"
+
+#include <utility>
+
+using namespace vacdm::com;
+
+// one buffer per request type is enough, larger responses than the limit are not kept
+static constexpr std::size_t __maximumPooledBuffers = 4;
+static constexpr std::size_t __maximumPooledCapacity = 4 * 1024 * 1024;
+
+ResponsePool::Lease::Lease(ResponsePool &pool, std::unique_ptr<std::string> buffer)
+    : m_pool(&pool), m_buffer(std::move(buffer)) {}
+
+ResponsePool::Lease::~Lease() {
+    if (nullptr != this->m_buffer) this->m_pool->release(std::move(this->m_buffer));
+}
+
+ResponsePool::Lease::Lease(Lease &&other) noexcept : m_pool(other.m_pool), m_buffer(std::move(other.m_buffer)) {}
+
+std::string &ResponsePool::Lease::data() { return *this->m_buffer; }
+
+const std::string &ResponsePool::Lease::data() const { return *this->m_buffer; }
+
+ResponsePool::ResponsePool() : m_lock(), m_buffers() {}
+
+ResponsePool::Lease ResponsePool::acquire() {
+    std::lock_guard guard(this->m_lock);
+
+    if (true == this->m_buffers.empty()) return Lease(*this, std::make_unique<std::string>());
+
+    auto buffer = std::move(this->m_buffers.back());
+    this->m_buffers.pop_back();
+    return Lease(*this, std::move(buffer));
+}
+
+void ResponsePool::release(std::unique_ptr<std::string> buffer) {
+    if (buffer->capacity() > __maximumPooledCapacity) return;
+    buffer->clear();
+
+    std::lock_guard guard(this->m_lock);
+    if (this->m_buffers.size() < __maximumPooledBuffers) this->m_buffers.push_back(std::move(buffer));
+}
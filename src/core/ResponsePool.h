@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace vacdm::com {
+/// @brief pool of response buffers which keep their capacity between requests
+/// @details Every request leases its own buffer, so concurrent requests never share a response. Released buffers
+/// are cleared and returned to the pool, oversized buffers are dropped to bound the retained memory.
+class ResponsePool {
+   public:
+    /// @brief a buffer owned by one request, it returns to the pool when the lease is destroyed
+    class Lease {
+       private:
+        ResponsePool *m_pool;
+        std::unique_ptr<std::string> m_buffer;
+
+       public:
+        Lease(ResponsePool &pool, std::unique_ptr<std::string> buffer);
+        ~Lease();
+        Lease(const Lease &) = delete;
+        Lease(Lease &&other) noexcept;
+        Lease &operator=(const Lease &) = delete;
+        Lease &operator=(Lease &&) = delete;
+
+        std::string &data();
+        const std::string &data() const;
+    };
+
+   private:
+    std::mutex m_lock;
+    std::vector<std::unique_ptr<std::string>> m_buffers;
+
+    void release(std::unique_ptr<std::string> buffer);
+
+   public:
+    ResponsePool();
+    ResponsePool(const ResponsePool &) = delete;
+    ResponsePool(ResponsePool &&) = delete;
+    ResponsePool &operator=(const ResponsePool &) = delete;
+    ResponsePool &operator=(ResponsePool &&) = delete;
+
+    /// @brief returns an empty buffer, a pooled one if available
+    Lease acquire();
+};
+}  // namespace vacdm::com
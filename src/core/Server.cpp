@@ -1,78 +1,100 @@
 #include "Server.h"
 
-#include <numeric>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <string_view>
+#include <utility>
 
 #include "Version.h"
+#include "core/PatchBody.h"
 #include "log/Logger.h"
+#include "types/PilotJson.h"
 #include "utils/Date.h"
 
 using namespace vacdm;
 using namespace vacdm::com;
 using namespace vacdm::logging;
+using namespace std::chrono_literals;
+
+static const Logger::LogLimit __rejectedRequestLogLimit{10s, 1};
+
+// the pilot fields which the DataManager needs for the merge, the tiers and the delta to EuroScope
+static constexpr std::string_view __pilotFields = "callsign,updatedAt,inactive,position,flightplan,clearance,vacdm";
+// the fields which are only shown by single tag items, they are requested once the tag item is used
+static constexpr std::pair<Server::OptionalField, const char*> __optionalPilotFields[] = {
+    {Server::OptionalField::EcfmpMeasures, "measures"},
+    {Server::OptionalField::EventBooking, "hasBooking"},
+};
+// the airports per pilot request, longer lists are requested in parallel chunks
+static constexpr std::size_t __airportsPerRequest = 8;
+
+/// @brief the target of a transfer, the body is reserved from the Content-Length header when the first chunk arrives
+struct Receiver {
+    CURL* socket;
+    std::string* body;
+    bool reserved;
+};
+
+static std::size_t receiveCurl(char* ptr, std::size_t size, std::size_t nmemb, void* userdata) {
+    auto receiver = static_cast<Receiver*>(userdata);
+    if (nullptr == receiver) return size * nmemb;
+
+    if (false == receiver->reserved) {
+        curl_off_t length = -1;
+        if (CURLE_OK == curl_easy_getinfo(receiver->socket, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) && length > 0)
+            receiver->body->reserve(receiver->body->size() + static_cast<std::size_t>(length));
+        receiver->reserved = true;
+    }
 
-static std::string __receivedDeleteData;
-static std::string __receivedGetData;
-static std::string __receivedPatchData;
-static std::string __receivedPostData;
-
-static std::size_t receiveCurlDelete(void* ptr, std::size_t size, std::size_t nmemb, void* stream) {
-    (void)stream;
-
-    std::string serverResult = static_cast<char*>(ptr);
-    __receivedDeleteData += serverResult;
-    return size * nmemb;
-}
-
-static std::size_t receiveCurlGet(void* ptr, std::size_t size, std::size_t nmemb, void* stream) {
-    (void)stream;
-
-    std::string serverResult = static_cast<char*>(ptr);
-    __receivedGetData += serverResult;
+    // the chunks are not zero-terminated
+    receiver->body->append(ptr, size * nmemb);
     return size * nmemb;
 }
 
-static std::size_t receiveCurlPatch(void* ptr, std::size_t size, std::size_t nmemb, void* stream) {
-    (void)stream;
-
-    std::string serverResult = static_cast<char*>(ptr);
-    __receivedPatchData += serverResult;
-    return size * nmemb;
-}
-
-static std::size_t receiveCurlPost(void* ptr, std::size_t size, std::size_t nmemb, void* stream) {
-    (void)stream;
-
-    std::string serverResult = static_cast<char*>(ptr);
-    __receivedPostData += serverResult;
-    return size * nmemb;
+/// @brief sends the prepared request of the socket and appends the response to the body
+static CURLcode performInto(CURL* socket, std::string& body) {
+    Receiver receiver{socket, &body, false};
+    curl_easy_setopt(socket, CURLOPT_WRITEDATA, &receiver);
+    const auto result = curl_easy_perform(socket);
+    curl_easy_setopt(socket, CURLOPT_WRITEDATA, nullptr);
+    return result;
 }
 
 Server::Server()
     : m_authToken(),
-      m_getRequest(),
-      m_postRequest(),
-      m_patchRequest(),
-      m_deleteRequest(),
+      m_getRequest("GET"),
+      m_postRequest("POST"),
+      m_patchRequest("PATCH"),
+      m_deleteRequest("DELETE"),
       m_apiIsChecked(false),
       m_apiIsValid(false),
-      m_baseUrl("https://app.vacdm.net"),
+      m_mirrors(),
       m_clientIsMaster(false),
-      m_errorCode() {
+      m_errorCode(),
+      m_requiredFields(0),
+      m_chunkRequests(curl_multi_init()),
+      m_chunkSockets() {
+    this->m_mirrors.setUrls({"https://app.vacdm.net"});
+
     /* configure the get request */
     curl_easy_setopt(m_getRequest.socket, CURLOPT_SSL_VERIFYPEER, 0L);
     curl_easy_setopt(m_getRequest.socket, CURLOPT_SSL_VERIFYHOST, 0L);
     curl_easy_setopt(m_getRequest.socket, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
     curl_easy_setopt(m_getRequest.socket, CURLOPT_HTTPGET, 1L);
-    curl_easy_setopt(m_getRequest.socket, CURLOPT_WRITEFUNCTION, receiveCurlGet);
+    curl_easy_setopt(m_getRequest.socket, CURLOPT_WRITEFUNCTION, receiveCurl);
+    curl_easy_setopt(m_getRequest.socket, CURLOPT_ACCEPT_ENCODING, "");
     curl_easy_setopt(m_getRequest.socket, CURLOPT_TIMEOUT, 2L);
 
     /* configure the post request */
     curl_easy_setopt(m_postRequest.socket, CURLOPT_SSL_VERIFYPEER, 0L);
     curl_easy_setopt(m_postRequest.socket, CURLOPT_SSL_VERIFYHOST, 0L);
     curl_easy_setopt(m_postRequest.socket, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
-    curl_easy_setopt(m_postRequest.socket, CURLOPT_WRITEFUNCTION, receiveCurlPost);
+    curl_easy_setopt(m_postRequest.socket, CURLOPT_WRITEFUNCTION, receiveCurl);
+    curl_easy_setopt(m_postRequest.socket, CURLOPT_ACCEPT_ENCODING, "");
     curl_easy_setopt(m_postRequest.socket, CURLOPT_CUSTOMREQUEST, "POST");
     curl_easy_setopt(m_postRequest.socket, CURLOPT_VERBOSE, 1);
+    curl_easy_setopt(m_postRequest.socket, CURLOPT_TIMEOUT, 5L);
     struct curl_slist* headers = nullptr;
     headers = curl_slist_append(headers, "Accept: application/json");
     headers = curl_slist_append(headers, ("Authorization: Bearer " + this->m_authToken).c_str());
@@ -83,9 +105,11 @@ Server::Server()
     curl_easy_setopt(m_patchRequest.socket, CURLOPT_SSL_VERIFYPEER, 0L);
     curl_easy_setopt(m_patchRequest.socket, CURLOPT_SSL_VERIFYHOST, 0L);
     curl_easy_setopt(m_patchRequest.socket, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
-    curl_easy_setopt(m_patchRequest.socket, CURLOPT_WRITEFUNCTION, receiveCurlPatch);
+    curl_easy_setopt(m_patchRequest.socket, CURLOPT_WRITEFUNCTION, receiveCurl);
+    curl_easy_setopt(m_patchRequest.socket, CURLOPT_ACCEPT_ENCODING, "");
     curl_easy_setopt(m_patchRequest.socket, CURLOPT_CUSTOMREQUEST, "PATCH");
     curl_easy_setopt(m_patchRequest.socket, CURLOPT_VERBOSE, 1);
+    curl_easy_setopt(m_patchRequest.socket, CURLOPT_TIMEOUT, 5L);
     curl_easy_setopt(m_patchRequest.socket, CURLOPT_HTTPHEADER, headers);
 
     /* configure the delete request */
@@ -93,7 +117,8 @@ Server::Server()
     curl_easy_setopt(m_deleteRequest.socket, CURLOPT_SSL_VERIFYHOST, 0L);
     curl_easy_setopt(m_deleteRequest.socket, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
     curl_easy_setopt(m_deleteRequest.socket, CURLOPT_CUSTOMREQUEST, "DELETE");
-    curl_easy_setopt(m_deleteRequest.socket, CURLOPT_WRITEFUNCTION, receiveCurlDelete);
+    curl_easy_setopt(m_deleteRequest.socket, CURLOPT_WRITEFUNCTION, receiveCurl);
+    curl_easy_setopt(m_deleteRequest.socket, CURLOPT_ACCEPT_ENCODING, "");
     curl_easy_setopt(m_deleteRequest.socket, CURLOPT_TIMEOUT, 2L);
 }
 
@@ -102,6 +127,11 @@ Server::~Server() {
         std::lock_guard guard(m_getRequest.lock);
         curl_easy_cleanup(m_getRequest.socket);
         m_getRequest.socket = nullptr;
+
+        for (const auto socket : this->m_chunkSockets) curl_easy_cleanup(socket);
+        this->m_chunkSockets.clear();
+        curl_multi_cleanup(this->m_chunkRequests);
+        this->m_chunkRequests = nullptr;
     }
 
     if (nullptr != m_postRequest.socket) {
@@ -123,10 +153,56 @@ Server::~Server() {
     }
 }
 
-void Server::changeServerAddress(const std::string& url) {
-    this->m_baseUrl = url;
+void Server::changeServerAddress(const std::string& url, const std::vector<std::string>& mirrors) {
+    std::vector<std::string> urls{url};
+    urls.insert(urls.end(), mirrors.cbegin(), mirrors.cend());
+    this->m_mirrors.setUrls(urls);
     this->m_apiIsChecked = false;
     this->m_apiIsValid = false;
+
+    // the failures of the previous server do not apply to the new one
+    this->m_getRequest.breaker.reset();
+    this->m_postRequest.breaker.reset();
+    this->m_patchRequest.breaker.reset();
+    this->m_deleteRequest.breaker.reset();
+}
+
+bool Server::perform(Communication& communication, std::string& response) {
+    const auto result = performInto(communication.socket, response);
+    return this->recordTransfer(communication, communication.socket, result, response);
+}
+
+bool Server::recordTransfer(Communication& communication, CURL* socket, CURLcode result,
+                            const std::string& response) {
+    if (false == this->countTransfer(communication, socket, result, response)) {
+        communication.breaker.recordFailure();
+        return false;
+    }
+
+    communication.breaker.recordSuccess();
+    return true;
+}
+
+bool Server::countTransfer(Communication& communication, CURL* socket, CURLcode result,
+                           const std::string& response) {
+    long responseCode = 0;
+    if (CURLE_OK == result) curl_easy_getinfo(socket, CURLINFO_RESPONSE_CODE, &responseCode);
+
+    curl_off_t sentBytes = 0, receivedBytes = 0;
+    curl_easy_getinfo(socket, CURLINFO_SIZE_UPLOAD_T, &sentBytes);
+    curl_easy_getinfo(socket, CURLINFO_SIZE_DOWNLOAD_T, &receivedBytes);
+    communication.transfer.requests += 1;
+    communication.transfer.sentBytes += static_cast<std::uint64_t>(sentBytes);
+    communication.transfer.receivedBytes += static_cast<std::uint64_t>(receivedBytes);
+    communication.transfer.decodedBytes += response.size();
+    Logger::instance().log(Logger::LogSender::Server,
+                           std::string(communication.name) + " transferred " + std::to_string(sentBytes) +
+                               " bytes sent, " + std::to_string(receivedBytes) + " bytes received, " +
+                               std::to_string(response.size()) + " bytes decoded",
+                           Logger::LogLevel::Debug);
+
+    // timeouts, connection errors and server errors indicate an outage, client errors concern the single request
+    return CURLE_OK == result && responseCode < 500 && 429 != responseCode;
 }
 
 bool Server::checkWebApi() {
@@ -138,14 +214,11 @@ bool Server::checkWebApi() {
         return m_apiIsValid;
     }
 
-    __receivedGetData.clear();
-
-    std::string url = m_baseUrl + "/api/v1/version";
-    curl_easy_setopt(m_getRequest.socket, CURLOPT_URL, url.c_str());
-
     // send the GET request
-    CURLcode result = curl_easy_perform(m_getRequest.socket);
-    if (result != CURLE_OK) {
+    long responseCode = 0;
+    const auto response = this->performGet("/api/v1/version", responseCode);
+    const auto& body = response.data();
+    if (0 == responseCode) {
         this->m_apiIsValid = false;
         return m_apiIsValid;
     }
@@ -154,10 +227,8 @@ bool Server::checkWebApi() {
     auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
     std::string errors;
     Json::Value root;
-    Logger::instance().log(Logger::LogSender::Server, "Received API-version-message: " + __receivedGetData,
-                           Logger::LogLevel::Info);
-    if (reader->parse(__receivedGetData.c_str(), __receivedGetData.c_str() + __receivedGetData.length(), &root,
-                      &errors)) {
+    Logger::instance().log(Logger::LogSender::Server, "Received API-version-message: " + body, Logger::LogLevel::Info);
+    if (reader->parse(body.data(), body.data() + body.size(), &root, &errors)) {
         if (PLUGIN_VERSION_MAJOR != root.get("major", Json::Value(-1)).asInt()) {
             this->m_errorCode = "Backend-version is incompatible. Please update the plugin.";
             this->m_apiIsValid = false;
@@ -166,7 +237,7 @@ bool Server::checkWebApi() {
         }
 
     } else {
-        this->m_errorCode = "Invalid backend-version response: " + __receivedGetData;
+        this->m_errorCode = "Invalid backend-version response: " + body;
         this->m_apiIsValid = false;
     }
     m_apiIsChecked = true;
@@ -178,23 +249,19 @@ Server::ServerConfiguration Server::getServerConfig() {
 
     std::lock_guard guard(m_getRequest.lock);
     if (nullptr != m_getRequest.socket) {
-        __receivedGetData.clear();
-
-        std::string url = m_baseUrl + "/api/v1/config";
-        curl_easy_setopt(m_getRequest.socket, CURLOPT_URL, url.c_str());
-
         /* send the command */
-        CURLcode result = curl_easy_perform(m_getRequest.socket);
-        if (CURLE_OK == result) {
+        long responseCode = 0;
+        const auto response = this->performGet("/api/v1/config", responseCode);
+        const auto& body = response.data();
+        if (0 != responseCode) {
             Json::CharReaderBuilder builder{};
             auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
             std::string errors;
             Json::Value root;
 
-            Logger::instance().log(Logger::LogSender::Server, "Received configuration: " + __receivedGetData,
+            Logger::instance().log(Logger::LogSender::Server, "Received configuration: " + body,
                                    Logger::LogLevel::Info);
-            if (reader->parse(__receivedGetData.c_str(), __receivedGetData.c_str() + __receivedGetData.length(), &root,
-                              &errors)) {
+            if (reader->parse(body.data(), body.data() + body.size(), &root, &errors)) {
                 ServerConfiguration_t config;
                 config.name = root["serverName"].asString();
                 config.allowMasterInSweatbox = root["allowSimSession"].asBool();
@@ -207,279 +274,525 @@ Server::ServerConfiguration Server::getServerConfig() {
     return ServerConfiguration();
 }
 
-std::list<types::Pilot> Server::getPilots(const std::list<std::string> airports) {
-    std::lock_guard guard(m_getRequest.lock);
-    if (nullptr != m_getRequest.socket) {
-        __receivedGetData.clear();
+std::string Server::pilotsEndpoint(const std::list<std::string>& airports, const std::string& fields) {
+    std::string endpoint = "/api/v1/pilots?";
+    for (const auto& airport : airports) endpoint += "adep=" + airport + "&";
+    return endpoint + "fields=" + fields;
+}
+
+std::list<types::Pilot> Server::parsePilots(const std::string& body) {
+    Json::CharReaderBuilder builder{};
+    auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
+    std::string errors;
+    Json::Value root;
 
-        std::string url = m_baseUrl + "/api/v1/pilots";
-        if (airports.size() != 0) {
-            url += "?adep=" +
-                   std::accumulate(std::next(airports.begin()), airports.end(), airports.front(),
-                                   [](const std::string& acc, const std::string& str) { return acc + "&adep=" + str; });
+    std::list<types::Pilot> pilots;
+    if (reader->parse(body.data(), body.data() + body.size(), &root, &errors) && root.isArray()) {
+        for (const auto& pilot : std::as_const(root)) {
+            pilots.push_back(types::Pilot());
+
+            types::parsePilot(pilot, pilots.back());
+            types::parseMeasures(pilot, pilots.back());
         }
-        Logger::instance().log(Logger::LogSender::Server, url, Logger::LogLevel::Info);
+    } else {
+        Logger::instance().log(Logger::LogSender::Server, "Error " + errors, Logger::LogLevel::Info);
+    }
 
-        curl_easy_setopt(m_getRequest.socket, CURLOPT_URL, url.c_str());
+    return pilots;
+}
 
-        // send GET request
-        CURLcode result = curl_easy_perform(m_getRequest.socket);
-        if (result == CURLE_OK) {
-            Json::CharReaderBuilder builder{};
-            auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
-            std::string errors;
-            Json::Value root;
+/// @brief a request of a chunk to one mirror, the receiver points into the response of the transfer
+struct HedgedTransfer {
+    std::size_t chunk;
+    std::size_t mirror;
+    CURL* socket;
+    ResponsePool::Lease response;
+    Receiver receiver;
+    bool running;
+};
+
+Server::HedgeStatistics Server::performHedged(const std::vector<std::string>& endpoints,
+                                              std::vector<ResponsePool::Lease>& responses,
+                                              std::vector<long>& responseCodes) {
+    const auto primary = this->m_mirrors.current();
+    const auto hedge = this->m_mirrors.hedgeTarget();
+    const auto hedgeDelay = this->m_mirrors.hedgeDelay();
+
+    // the GET socket and its copies keep their connections between the cycles, a hedge needs a socket as well
+    std::vector<CURL*> sockets{m_getRequest.socket};
+    sockets.insert(sockets.end(), this->m_chunkSockets.cbegin(), this->m_chunkSockets.cend());
+
+    // the receivers are referenced by the sockets, the deque keeps their addresses stable
+    std::deque<HedgedTransfer> transfers;
+    const auto start = [&](std::size_t chunk, std::size_t mirror) {
+        if (sockets.size() == transfers.size()) {
+            const auto socket = curl_easy_duphandle(m_getRequest.socket);
+            if (nullptr == socket) return false;
+            this->m_chunkSockets.push_back(socket);
+            sockets.push_back(socket);
+        }
 
-            // Logger::instance().log(Logger::LogSender::Server, "Received data" + __receivedGetData,
-            //                        Logger::LogLevel::Debug);
-            if (reader->parse(__receivedGetData.c_str(), __receivedGetData.c_str() + __receivedGetData.length(), &root,
-                              &errors) &&
-                root.isArray()) {
-                std::list<types::Pilot> pilots;
-
-                for (const auto& pilot : std::as_const(root)) {
-                    pilots.push_back(types::Pilot());
-
-                    pilots.back().callsign = pilot["callsign"].asString();
-                    pilots.back().lastUpdate = utils::Date::isoStringToTimestamp(pilot["updatedAt"].asString());
-                    pilots.back().inactive = pilot["inactive"].asBool();
-
-                    // position data
-                    pilots.back().latitude = pilot["position"]["lat"].asDouble();
-                    pilots.back().longitude = pilot["position"]["lon"].asDouble();
-                    pilots.back().taxizoneIsTaxiout = pilot["vacdm"]["taxizoneIsTaxiout"].asBool();
-
-                    // flightplan & clearance data
-                    pilots.back().origin = pilot["flightplan"]["departure"].asString();
-                    pilots.back().destination = pilot["flightplan"]["arrival"].asString();
-                    pilots.back().runway = pilot["clearance"]["dep_rwy"].asString();
-                    pilots.back().sid = pilot["clearance"]["sid"].asString();
-
-                    // ACDM procedure data
-                    pilots.back().eobt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["eobt"].asString());
-                    pilots.back().tobt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["tobt"].asString());
-                    pilots.back().tobt_state = pilot["vacdm"]["tobt_state"].asString();
-                    pilots.back().ctot = utils::Date::isoStringToTimestamp(pilot["vacdm"]["ctot"].asString());
-                    pilots.back().ttot = utils::Date::isoStringToTimestamp(pilot["vacdm"]["ttot"].asString());
-                    pilots.back().tsat = utils::Date::isoStringToTimestamp(pilot["vacdm"]["tsat"].asString());
-                    pilots.back().exot =
-                        std::chrono::utc_clock::time_point(std::chrono::minutes(pilot["vacdm"]["exot"].asInt64()));
-                    pilots.back().asat = utils::Date::isoStringToTimestamp(pilot["vacdm"]["asat"].asString());
-                    pilots.back().aobt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["aobt"].asString());
-                    pilots.back().atot = utils::Date::isoStringToTimestamp(pilot["vacdm"]["atot"].asString());
-                    pilots.back().asrt = utils::Date::isoStringToTimestamp(pilot["vacdm"]["asrt"].asString());
-                    pilots.back().aort = utils::Date::isoStringToTimestamp(pilot["vacdm"]["aort"].asString());
-
-                    // ECFMP measures
-                    Json::Value measuresArray = pilot["measures"];
-                    std::vector<types::EcfmpMeasure> parsedMeasures;
-                    for (const auto& measureObject : std::as_const(measuresArray)) {
-                        vacdm::types::EcfmpMeasure measure;
-
-                        measure.ident = measureObject["ident"].asString();
-                        measure.value = measureObject["value"].asInt();
-
-                        parsedMeasures.push_back(measure);
-                    }
-                    pilots.back().measures = parsedMeasures;
-
-                    // event booking data
-                    pilots.back().hasBooking = pilot["hasBooking"].asBool();
+        const auto socket = sockets[transfers.size()];
+        auto& transfer = transfers.emplace_back(
+            HedgedTransfer{chunk, mirror, socket, this->m_responses.acquire(), Receiver{}, true});
+        transfer.receiver = {socket, &transfer.response.data(), false};
+
+        const auto url = this->m_mirrors.url(mirror) + endpoints[chunk];
+        curl_easy_setopt(socket, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(socket, CURLOPT_WRITEDATA, &transfer.receiver);
+        curl_multi_add_handle(this->m_chunkRequests, socket);
+        return true;
+    };
+    const auto stop = [&](HedgedTransfer& transfer, CURLcode result) {
+        transfer.running = false;
+        curl_multi_remove_handle(this->m_chunkRequests, transfer.socket);
+        curl_easy_setopt(transfer.socket, CURLOPT_WRITEDATA, nullptr);
+        return this->countTransfer(m_getRequest, transfer.socket, result, transfer.response.data());
+    };
+
+    HedgeStatistics statistics;
+    std::vector<bool> finished(endpoints.size(), false), hedged(endpoints.size(), MirrorSet::None == hedge);
+    std::size_t pending = endpoints.size();
+    for (std::size_t i = 0; i < endpoints.size(); ++i) {
+        if (true == start(i, primary)) continue;
+
+        finished[i] = true;
+        pending -= 1;
+    }
+    curl_off_t sequentialTime = 0;
+    const auto begin = std::chrono::steady_clock::now();
+
+    while (0 != pending) {
+        int running = 0;
+        curl_multi_perform(this->m_chunkRequests, &running);
+
+        int queued = 0;
+        while (const auto message = curl_multi_info_read(this->m_chunkRequests, &queued)) {
+            if (CURLMSG_DONE != message->msg) continue;
+
+            const auto transfer = std::find_if(transfers.begin(), transfers.end(), [message](const auto& transfer) {
+                return true == transfer.running && message->easy_handle == transfer.socket;
+            });
+            if (transfers.end() == transfer) continue;
+
+            const auto chunk = transfer->chunk;
+            const auto result = message->data.result;
+            if (false == stop(*transfer, result)) {
+                this->m_mirrors.recordFailure(transfer->mirror);
+
+                // the other request of the chunk may still answer, a failed chunk is sent to the other mirror
+                const auto sibling = std::find_if(transfers.cbegin(), transfers.cend(), [chunk](const auto& other) {
+                    return true == other.running && chunk == other.chunk;
+                });
+                if (transfers.cend() != sibling) continue;
+                if (false == hedged[chunk] && transfer->mirror != hedge && true == start(chunk, hedge)) {
+                    hedged[chunk] = true;
+                    statistics.hedges += 1;
+                    continue;
                 }
-                Logger::instance().log(Logger::LogSender::Server, "Pilots size: " + std::to_string(pilots.size()),
-                                       Logger::LogLevel::Info);
-                return pilots;
+
+                finished[chunk] = true;
+                pending -= 1;
+                continue;
+            }
+
+            curl_off_t totalTime = 0;
+            curl_easy_getinfo(transfer->socket, CURLINFO_TOTAL_TIME_T, &totalTime);
+            curl_easy_getinfo(transfer->socket, CURLINFO_RESPONSE_CODE, &responseCodes[chunk]);
+            sequentialTime += totalTime;
+            this->m_mirrors.recordSuccess(transfer->mirror, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                                std::chrono::microseconds(totalTime)));
+            if (primary != transfer->mirror) this->m_mirrors.recordHedgeWin(transfer->mirror);
+            responses[chunk].data().swap(transfer->response.data());
+
+            // the first answer wins, the other request of the chunk is cancelled
+            for (auto& other : transfers) {
+                if (true == other.running && chunk == other.chunk) stop(other, CURLE_ABORTED_BY_CALLBACK);
+            }
+            finished[chunk] = true;
+            pending -= 1;
+        }
+        if (0 == pending) break;
+
+        // the chunks which are not answered within the p95 latency of the current mirror are sent to another one
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+        bool hedgePending = false;
+        for (std::size_t i = 0; i < endpoints.size(); ++i) {
+            if (true == finished[i] || true == hedged[i]) continue;
+
+            if (elapsed >= hedgeDelay) {
+                hedged[i] = true;
+                if (true == start(i, hedge)) statistics.hedges += 1;
             } else {
-                Logger::instance().log(Logger::LogSender::Server, "Error " + errors, Logger::LogLevel::Info);
+                hedgePending = true;
             }
         }
+
+        const auto timeout = true == hedgePending
+                                 ? std::chrono::duration_cast<std::chrono::milliseconds>(hedgeDelay - elapsed).count()
+                                 : 1000;
+        curl_multi_poll(this->m_chunkRequests, nullptr, 0, static_cast<int>(std::max<long long>(timeout, 1)), nullptr);
+    }
+
+    // the chunks and their hedges are a single request for the circuit breaker, e.g. its single half-open probe, it
+    // succeeds if every chunk was answered by any mirror
+    if (std::none_of(responseCodes.cbegin(), responseCodes.cend(), [](long code) { return 0 == code; }))
+        m_getRequest.breaker.recordSuccess();
+    else
+        m_getRequest.breaker.recordFailure();
+
+    statistics.sequentialTime =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::microseconds(sequentialTime));
+    return statistics;
+}
+
+ResponsePool::Lease Server::performGet(const std::string& endpointUrl, long& responseCode) {
+    std::vector<ResponsePool::Lease> responses;
+    responses.push_back(this->m_responses.acquire());
+    std::vector<long> responseCodes(1, 0);
+
+    this->performHedged({endpointUrl}, responses, responseCodes);
+    responseCode = responseCodes.front();
+    return std::move(responses.front());
+}
+
+void Server::requireField(OptionalField field) {
+    this->m_requiredFields.fetch_or(static_cast<std::uint32_t>(field), std::memory_order_relaxed);
+}
+
+std::string Server::pilotFields(bool allFields, std::string* omittedFields) const {
+    // only the fields of the tag items in use are requested
+    const auto requiredFields = this->m_requiredFields.load(std::memory_order_relaxed);
+    std::string fields(__pilotFields);
+    for (const auto& [field, name] : __optionalPilotFields) {
+        if (true == allFields || 0 != (requiredFields & static_cast<std::uint32_t>(field)))
+            fields += std::string(",") + name;
+        else if (nullptr != omittedFields)
+            *omittedFields += std::string(omittedFields->empty() ? "" : ",") + name;
+    }
+
+    return fields;
+}
+
+bool Server::requestPilots(const std::list<std::string>& airports, const std::string& fields,
+                           const std::function<std::size_t(const std::string&)>& consume,
+                           const std::string& omittedFields) {
+    std::lock_guard guard(m_getRequest.lock);
+    if (nullptr == m_getRequest.socket) return false;
+
+    if (false == m_getRequest.breaker.allowRequest()) {
+        Logger::instance().logLimited(Logger::LogSender::Server, "getPilots:rejected", __rejectedRequestLogLimit,
+                                      "GET circuit open, skipped the pilot request", Logger::LogLevel::Warning);
+        return false;
+    }
+
+    // long airport lists are split into chunks, which are requested in parallel
+    std::vector<std::string> endpoints;
+    std::list<std::string> chunk;
+    for (const auto& airport : airports) {
+        chunk.push_back(airport);
+        if (__airportsPerRequest == chunk.size()) {
+            endpoints.push_back(Server::pilotsEndpoint(chunk, fields));
+            chunk.clear();
+        }
+    }
+    if (false == chunk.empty() || true == endpoints.empty())
+        endpoints.push_back(Server::pilotsEndpoint(chunk, fields));
+    if (1 == endpoints.size())
+        Logger::instance().log(Logger::LogSender::Server, endpoints.front(), Logger::LogLevel::Info);
+
+    std::vector<ResponsePool::Lease> responses;
+    for (std::size_t i = 0; i < endpoints.size(); ++i) responses.push_back(this->m_responses.acquire());
+    std::vector<long> responseCodes(endpoints.size(), 0);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto receivedBefore = m_getRequest.transfer.receivedBytes.load();
+    const auto statistics = this->performHedged(endpoints, responses, responseCodes);
+    const auto duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    std::string parallelism;
+    if (1 != endpoints.size())
+        parallelism = " (" + std::to_string(statistics.sequentialTime.count()) + " ms sequential)";
+    if (0 != statistics.hedges) parallelism += ", " + std::to_string(statistics.hedges) + " hedged";
+
+    std::size_t pilots = 0, decodedBytes = 0;
+    for (std::size_t i = 0; i < endpoints.size(); ++i) {
+        if (0 == responseCodes[i]) continue;
+
+        decodedBytes += responses[i].data().size();
+        pilots += consume(responses[i].data());
     }
 
-    return {};
+    Logger::instance().log(Logger::LogSender::Server,
+                           "Pilots size: " + std::to_string(pilots) + " in " + std::to_string(endpoints.size()) +
+                               " requests, " + std::to_string(duration.count()) + " ms" + parallelism + ", " +
+                               std::to_string(m_getRequest.transfer.receivedBytes.load() - receivedBefore) +
+                               " bytes received, " + std::to_string(decodedBytes) + " bytes decoded" +
+                               (omittedFields.empty() ? "" : ", omitted " + omittedFields),
+                           Logger::LogLevel::Info);
+    return std::none_of(responseCodes.cbegin(), responseCodes.cend(), [](long code) { return 0 == code; });
+}
+
+std::list<types::Pilot> Server::getPilots(const std::list<std::string> airports) {
+    std::string omittedFields;
+    const auto fields = this->pilotFields(false, &omittedFields);
+
+    std::list<types::Pilot> pilots;
+    this->requestPilots(
+        airports, fields,
+        [&pilots](const std::string& body) {
+            const auto size = pilots.size();
+            pilots.splice(pilots.end(), Server::parsePilots(body));
+            return pilots.size() - size;
+        },
+        omittedFields);
+
+    return pilots;
+}
+
+bool Server::getPilotsJson(const std::list<std::string>& airports, Json::Value& pilots) {
+    Json::CharReaderBuilder builder{};
+    auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
+
+    pilots = Json::Value(Json::arrayValue);
+    bool parsed = true;
+    const auto answered = this->requestPilots(airports, this->pilotFields(true, nullptr), [&](const std::string& body) {
+        std::string errors;
+        Json::Value root;
+        if (false == reader->parse(body.data(), body.data() + body.size(), &root, &errors) || false == root.isArray()) {
+            Logger::instance().log(Logger::LogSender::Server, "Error " + errors, Logger::LogLevel::Info);
+            parsed = false;
+            return std::size_t(0);
+        }
+
+        for (auto& pilot : root) pilots.append(std::move(pilot));
+        return static_cast<std::size_t>(root.size());
+    });
+
+    return true == answered && true == parsed;
+}
+
+bool Server::getDocument(const std::string& endpointUrl, std::string& response, long& responseCode) {
+    std::lock_guard guard(m_getRequest.lock);
+    if (nullptr == m_getRequest.socket || false == m_getRequest.breaker.allowRequest()) return false;
+
+    // copy the body, the pooled buffer keeps its capacity for the next request
+    const auto lease = this->performGet(endpointUrl, responseCode);
+    response.assign(lease.data());
+    return 0 != responseCode;
 }
 
 void Server::sendPostMessage(const std::string& endpointUrl, const Json::Value& root) {
     if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return;
 
     Json::StreamWriterBuilder builder{};
+    builder["indentation"] = "";
     const auto message = Json::writeString(builder, root);
 
     Logger::instance().log(Logger::LogSender::Server,
                            "Posting " + root["callsign"].asString() + " with message: " + message,
-                           Logger::LogLevel::Debug);
+                           Logger::LogLevel::Debug, {root["callsign"].asString(), "", "Post"});
 
-    std::lock_guard guard(this->m_postRequest.lock);
-    if (m_postRequest.socket != nullptr) {
-        std::string url = m_baseUrl + endpointUrl;
-        curl_easy_setopt(m_postRequest.socket, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(m_postRequest.socket, CURLOPT_POSTFIELDS, message.c_str());
+    this->queueWrite(Outbox::Method::Post, root["callsign"].asString(), endpointUrl, message);
+}
 
-        curl_easy_perform(m_postRequest.socket);
+void Server::sendPatchMessage(const std::string& endpointUrl, const Json::Value& root) {
+    Json::StreamWriterBuilder builder{};
+    builder["indentation"] = "";
 
-        Logger::instance().log(Logger::LogSender::Server,
-                               "Posted " + root["callsign"].asString() + " response: " + __receivedPostData,
-                               Logger::LogLevel::Debug);
-        __receivedPostData.clear();
-    }
+    this->sendPatchBody(endpointUrl, root["callsign"].asString(), Json::writeString(builder, root));
 }
 
-void Server::sendPatchMessage(const std::string& endpointUrl, const Json::Value& root) {
+void Server::sendPatchBody(const std::string& endpointUrl, const std::string& callsign, const std::string& message) {
     if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return;
 
-    Json::StreamWriterBuilder builder{};
-    const auto message = Json::writeString(builder, root);
+    Logger::instance().log(Logger::LogSender::Server, "Patching " + callsign + " with message: " + message,
+                           Logger::LogLevel::Debug, {callsign, "", "Patch"});
 
-    Logger::instance().log(Logger::LogSender::Server,
-                           "Patching " + root["callsign"].asString() + " with message: " + message,
-                           Logger::LogLevel::Debug);
+    this->queueWrite(Outbox::Method::Patch, callsign, endpointUrl, message);
+}
+
+void Server::sendDeleteMessage(const std::string& endpointUrl) {
+    if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return;
+
+    // the pilot endpoints end with the callsign, it groups the delete with the other writes of the pilot
+    const auto separator = endpointUrl.find_last_of('/');
+    const auto callsign = std::string::npos != separator ? endpointUrl.substr(separator + 1) : endpointUrl;
 
-    std::lock_guard guard(this->m_patchRequest.lock);
-    if (m_patchRequest.socket != nullptr) {
-        std::string url = m_baseUrl + endpointUrl;
-        curl_easy_setopt(m_patchRequest.socket, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(m_patchRequest.socket, CURLOPT_POSTFIELDS, message.c_str());
+    this->queueWrite(Outbox::Method::Delete, callsign, endpointUrl, "");
+}
+
+bool Server::forwardWrite(Outbox::Method method, const std::string& callsign, const std::string& endpointUrl,
+                          const std::string& message) {
+    if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return false;
+
+    Logger::instance().log(Logger::LogSender::Server, "Forwarding " + endpointUrl + " with message: " + message,
+                           Logger::LogLevel::Debug, {callsign, "", "Forward"});
+
+    // the relay answers once the write is journaled, its writer thread sends it with flushOutbox
+    this->m_outbox.append(method, callsign, endpointUrl, message);
+    return true;
+}
 
-        curl_easy_perform(m_patchRequest.socket);
+void Server::queueWrite(Outbox::Method method, const std::string& callsign, const std::string& endpointUrl,
+                        const std::string& message) {
+    this->m_outbox.append(method, callsign, endpointUrl, message);
+    this->flushOutbox();
+}
+
+void Server::openOutbox(const std::string& filename) {
+    this->m_outbox.open(filename);
 
+    const auto pending = this->m_outbox.size();
+    if (0 != pending)
         Logger::instance().log(Logger::LogSender::Server,
-                               "Patched " + root["callsign"].asString() + " response: " + __receivedPatchData,
-                               Logger::LogLevel::Debug);
-        __receivedPatchData.clear();
-    }
+                               "Restored " + std::to_string(pending) + " undelivered writes from the outbox",
+                               Logger::LogLevel::Info);
 }
 
-void Server::sendDeleteMessage(const std::string& endpointUrl) {
+void Server::flushOutbox() {
     if (this->m_apiIsChecked == false || this->m_apiIsValid == false || this->m_clientIsMaster == false) return;
 
-    Json::StreamWriterBuilder builder{};
+    std::lock_guard guard(this->m_outboxLock);
+    for (const auto& entry : this->m_outbox.pending()) {
+        // keep the order, the remaining writes are replayed once the backend is reachable again
+        if (false == this->send(entry)) break;
+        this->m_outbox.acknowledge(entry.sequences);
+    }
+}
 
-    std::lock_guard guard(this->m_deleteRequest.lock);
-    if (m_deleteRequest.socket != nullptr) {
-        std::string url = m_baseUrl + endpointUrl;
+std::size_t Server::pendingWrites() { return this->m_outbox.size(); }
+
+bool Server::send(const Outbox::Entry& entry) {
+    Communication* communication = nullptr;
+    switch (entry.method) {
+        case Outbox::Method::Post:
+            communication = &this->m_postRequest;
+            break;
+        case Outbox::Method::Patch:
+            communication = &this->m_patchRequest;
+            break;
+        case Outbox::Method::Delete:
+            communication = &this->m_deleteRequest;
+            break;
+        default:
+            // unknown entries of a damaged journal are acknowledged and dropped
+            return true;
+    }
 
-        curl_easy_setopt(m_deleteRequest.socket, CURLOPT_URL, url.c_str());
+    std::lock_guard guard(communication->lock);
+    if (nullptr == communication->socket) return false;
+
+    if (false == communication->breaker.allowRequest()) {
+        Logger::instance().logLimited(Logger::LogSender::Server, "send:rejected", __rejectedRequestLogLimit,
+                                      "Circuit open, kept " + std::to_string(this->m_outbox.size()) +
+                                          " writes in the outbox",
+                                      Logger::LogLevel::Warning, {entry.callsign, "", "Outbox"});
+        return false;
+    }
 
-        curl_easy_perform(m_deleteRequest.socket);
-        __receivedDeleteData.clear();
+    // the writes are not hedged, they are sent to the current mirror only
+    const auto mirror = this->m_mirrors.current();
+    std::string url = this->m_mirrors.url(mirror) + entry.endpoint;
+    curl_easy_setopt(communication->socket, CURLOPT_URL, url.c_str());
+    if (Outbox::Method::Delete != entry.method)
+        curl_easy_setopt(communication->socket, CURLOPT_POSTFIELDS, entry.body.c_str());
+
+    auto response = this->m_responses.acquire();
+    const auto delivered = this->perform(*communication, response.data());
+    if (true == delivered) {
+        curl_off_t totalTime = 0;
+        curl_easy_getinfo(communication->socket, CURLINFO_TOTAL_TIME_T, &totalTime);
+        this->m_mirrors.recordSuccess(
+            mirror, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::microseconds(totalTime)));
+    } else {
+        this->m_mirrors.recordFailure(mirror);
     }
+
+    Logger::instance().log(Logger::LogSender::Server,
+                           "Sent " + entry.endpoint + " (" + std::to_string(entry.sequences.size()) +
+                               " writes) response: " + response.data(),
+                           Logger::LogLevel::Debug, {entry.callsign, "", "Outbox"});
+
+    return delivered;
 }
 
 void Server::postPilot(types::Pilot pilot) {
     Json::Value root;
 
-    root["callsign"] = pilot.callsign;
+    types::serializePilot(pilot, root);
+    // new pilots are always posted as active
     root["inactive"] = false;
 
-    root["position"] = Json::Value();
-    root["position"]["lat"] = pilot.latitude;
-    root["position"]["lon"] = pilot.longitude;
-
-    root["flightplan"] = Json::Value();
-    root["flightplan"]["departure"] = pilot.origin;
-    root["flightplan"]["arrival"] = pilot.destination;
-
-    root["vacdm"] = Json::Value();
-    root["vacdm"]["eobt"] = utils::Date::timestampToIsoString(pilot.eobt);
-    root["vacdm"]["tobt"] = utils::Date::timestampToIsoString(pilot.tobt);
-
-    root["clearance"] = Json::Value();
-    root["clearance"]["dep_rwy"] = pilot.runway;
-    root["clearance"]["sid"] = pilot.sid;
-
     this->sendPostMessage("/api/v1/pilots", root);
 }
 
 void Server::updateExot(const std::string& callsign, const std::chrono::utc_clock::time_point& exot) {
-    Json::Value root;
-
-    root["callsign"] = callsign;
-    root["vacdm"] = Json::Value();
-    root["vacdm"]["exot"] = std::chrono::duration_cast<std::chrono::minutes>(exot.time_since_epoch()).count();
-    root["vacdm"]["tsat"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["ttot"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["asat"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["aobt"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["atot"] = utils::Date::timestampToIsoString(types::defaultTime);
-
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    PatchBody body(callsign);
+    body.minutes(PatchBody::Exot, exot)
+        .reset(PatchBody::Tsat)
+        .reset(PatchBody::Ttot)
+        .reset(PatchBody::Asat)
+        .reset(PatchBody::Aobt)
+        .reset(PatchBody::Atot);
+
+    this->sendPatchBody("/api/v1/pilots/" + callsign, callsign, body.finish());
 }
 
 void Server::updateTobt(const types::Pilot& pilot, const std::chrono::utc_clock::time_point& tobt, bool manualTobt) {
-    Json::Value root;
-
     bool resetTsat = (tobt == types::defaultTime && true == manualTobt) || tobt >= pilot.tsat;
-    root["callsign"] = pilot.callsign;
-    root["vacdm"] = Json::Value();
 
-    root["vacdm"] = Json::Value();
-    root["vacdm"]["tobt"] = utils::Date::timestampToIsoString(tobt);
-    if (true == resetTsat) root["vacdm"]["tsat"] = utils::Date::timestampToIsoString(types::defaultTime);
-    if (false == manualTobt) root["vacdm"]["tobt_state"] = "CONFIRMED";
+    PatchBody body(pilot.callsign);
+    body.time(PatchBody::Tobt, tobt);
+    if (true == resetTsat) body.reset(PatchBody::Tsat);
+    if (false == manualTobt) body.string(PatchBody::TobtState, "CONFIRMED");
+    body.reset(PatchBody::Ttot).reset(PatchBody::Asat).reset(PatchBody::Aobt).reset(PatchBody::Atot);
 
-    root["vacdm"]["ttot"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["asat"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["aobt"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["atot"] = utils::Date::timestampToIsoString(types::defaultTime);
-
-    this->sendPatchMessage("/api/v1/pilots/" + pilot.callsign, root);
+    this->sendPatchBody("/api/v1/pilots/" + pilot.callsign, pilot.callsign, body.finish());
 }
 
 void Server::updateAsat(const std::string& callsign, const std::chrono::utc_clock::time_point& asat) {
-    Json::Value root;
+    PatchBody body(callsign);
+    body.time(PatchBody::Asat, asat);
 
-    root["callsign"] = callsign;
-    root["vacdm"] = Json::Value();
-    root["vacdm"]["asat"] = utils::Date::timestampToIsoString(asat);
-
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    this->sendPatchBody("/api/v1/pilots/" + callsign, callsign, body.finish());
 }
 
 void Server::updateAsrt(const std::string& callsign, const std::chrono::utc_clock::time_point& asrt) {
-    Json::Value root;
-
-    root["callsign"] = callsign;
-    root["vacdm"] = Json::Value();
-    root["vacdm"]["asrt"] = utils::Date::timestampToIsoString(asrt);
+    PatchBody body(callsign);
+    body.time(PatchBody::Asrt, asrt);
 
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    this->sendPatchBody("/api/v1/pilots/" + callsign, callsign, body.finish());
 }
 
 void Server::updateAobt(const std::string& callsign, const std::chrono::utc_clock::time_point& aobt) {
-    Json::Value root;
-
-    root["callsign"] = callsign;
-    root["vacdm"] = Json::Value();
-    root["vacdm"]["aobt"] = utils::Date::timestampToIsoString(aobt);
+    PatchBody body(callsign);
+    body.time(PatchBody::Aobt, aobt);
 
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    this->sendPatchBody("/api/v1/pilots/" + callsign, callsign, body.finish());
 }
 
 void Server::updateAort(const std::string& callsign, const std::chrono::utc_clock::time_point& aort) {
-    Json::Value root;
-
-    root["callsign"] = callsign;
-    root["vacdm"] = Json::Value();
-    root["vacdm"]["aort"] = utils::Date::timestampToIsoString(aort);
+    PatchBody body(callsign);
+    body.time(PatchBody::Aort, aort);
 
-    this->sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    this->sendPatchBody("/api/v1/pilots/" + callsign, callsign, body.finish());
 }
 
 void Server::resetTobt(const std::string& callsign, const std::chrono::utc_clock::time_point& tobt,
                        const std::string& tobtState) {
-    Json::Value root;
-
-    root["callsign"] = callsign;
-    root["vacdm"] = Json::Value();
-    root["vacdm"]["tobt"] = utils::Date::timestampToIsoString(tobt);
-    root["vacdm"]["tobt_state"] = tobtState;
-    root["vacdm"]["tsat"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["ttot"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["asat"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["asrt"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["aobt"] = utils::Date::timestampToIsoString(types::defaultTime);
-    root["vacdm"]["atot"] = utils::Date::timestampToIsoString(types::defaultTime);
-
-    sendPatchMessage("/api/v1/pilots/" + callsign, root);
+    PatchBody body(callsign);
+    body.time(PatchBody::Tobt, tobt)
+        .string(PatchBody::TobtState, tobtState)
+        .reset(PatchBody::Tsat)
+        .reset(PatchBody::Ttot)
+        .reset(PatchBody::Asat)
+        .reset(PatchBody::Asrt)
+        .reset(PatchBody::Aobt)
+        .reset(PatchBody::Atot);
+
+    this->sendPatchBody("/api/v1/pilots/" + callsign, callsign, body.finish());
 }
 
 void Server::deletePilot(const std::string& callsign) { sendDeleteMessage("/api/v1/pilots/" + callsign); }
@@ -490,6 +803,33 @@ bool Server::getMaster() { return this->m_clientIsMaster; }
 
 const std::string& Server::errorMessage() const { return this->m_errorCode; }
 
+std::vector<std::string> Server::breakerStatus() {
+    return {this->m_getRequest.breaker.status(), this->m_postRequest.breaker.status(),
+            this->m_patchRequest.breaker.status(), this->m_deleteRequest.breaker.status()};
+}
+
+std::vector<std::string> Server::mirrorStatus() { return this->m_mirrors.status(); }
+
+std::vector<std::string> Server::transferStatus() {
+    std::vector<std::string> status;
+
+    for (const auto communication :
+         {&this->m_getRequest, &this->m_postRequest, &this->m_patchRequest, &this->m_deleteRequest}) {
+        const auto& transfer = communication->transfer;
+        const std::uint64_t received = transfer.receivedBytes, decoded = transfer.decodedBytes;
+
+        std::string ratio;
+        if (0 != decoded) ratio = ", " + std::to_string(received * 100 / decoded) + " % on the wire";
+
+        status.push_back(std::string(communication->name) + ": " + std::to_string(transfer.requests) +
+                         " requests, " + std::to_string(transfer.sentBytes) + " bytes sent, " +
+                         std::to_string(received) + " bytes received, " + std::to_string(decoded) + " bytes decoded" +
+                         ratio);
+    }
+
+    return status;
+}
+
 Server& Server::instance() {
     static Server __instance;
     return __instance;
@@ -4,10 +4,19 @@
 #include <curl/curl.h>
 #include <json/json.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <mutex>
 #include <string>
+#include <vector>
 
+#include "core/CircuitBreaker.h"
+#include "core/MirrorSet.h"
+#include "core/Outbox.h"
+#include "core/ResponsePool.h"
 #include "types/Pilot.h"
 
 namespace vacdm::com {
@@ -21,11 +30,22 @@ class Server {
 
    private:
     Server();
+    /// @brief the transferred bytes of an endpoint, the received bytes are counted before the decompression
+    struct TransferMetrics {
+        std::atomic<std::uint64_t> requests{0};
+        std::atomic<std::uint64_t> sentBytes{0};
+        std::atomic<std::uint64_t> receivedBytes{0};
+        std::atomic<std::uint64_t> decodedBytes{0};
+    };
     struct Communication {
         std::mutex lock;
         CURL* socket;
+        const char* name;
+        CircuitBreaker breaker;
+        TransferMetrics transfer;
 
-        Communication() : lock(), socket(curl_easy_init()) {}
+        explicit Communication(const char* name)
+            : lock(), socket(curl_easy_init()), name(name), breaker(name), transfer() {}
     };
 
     std::string m_authToken;
@@ -36,12 +56,72 @@ class Server {
 
     bool m_apiIsChecked;
     bool m_apiIsValid;
-    std::string m_baseUrl;
+    /// @brief the base url of the backend and its mirrors
+    MirrorSet m_mirrors;
     bool m_clientIsMaster;
     std::string m_errorCode;
     ServerConfiguration m_serverConfiguration;
+    /// @brief the optional fields which are requested with the pilots
+    std::atomic<std::uint32_t> m_requiredFields;
+    /// @brief requests the pilot chunks and their hedges in parallel, guarded by the lock of the GET request
+    CURLM* m_chunkRequests;
+    std::vector<CURL*> m_chunkSockets;
+    Outbox m_outbox;
+    ResponsePool m_responses;
+    /// @brief serializes the replay of the outbox, the entries are sent in order
+    std::mutex m_outboxLock;
+
+    /// @brief sends the prepared request and records the result in the circuit breaker of the communication
+    /// @return true if the backend answered, responses with client errors count as answered
+    /// @param response receives the response body
+    bool perform(Communication& communication, std::string& response);
+    /// @brief records the result of a finished transfer of the socket in the metrics and the circuit breaker
+    bool recordTransfer(Communication& communication, CURL* socket, CURLcode result, const std::string& response);
+    /// @brief records a finished transfer of the socket in the metrics
+    /// @return true if the backend answered, responses with client errors count as answered
+    bool countTransfer(Communication& communication, CURL* socket, CURLcode result, const std::string& response);
+    static std::string pilotsEndpoint(const std::list<std::string>& airports, const std::string& fields);
+    /// @brief returns the requested pilot fields, either the required or all optional fields
+    /// @param omittedFields receives the optional fields which are not requested
+    std::string pilotFields(bool allFields, std::string* omittedFields) const;
+    /// @brief requests the pilots of the airports in chunks and passes every answered response to the consumer
+    /// @param consume parses a response and returns the number of contained pilots
+    /// @return true if every chunk was answered
+    bool requestPilots(const std::list<std::string>& airports, const std::string& fields,
+                       const std::function<std::size_t(const std::string&)>& consume,
+                       const std::string& omittedFields = "");
+    static std::list<types::Pilot> parsePilots(const std::string& body);
+    struct HedgeStatistics {
+        /// @brief the summed duration of the answered requests, i.e. the duration of sequential requests
+        std::chrono::milliseconds sequentialTime{0};
+        /// @brief the requests which were sent to a second mirror
+        std::size_t hedges = 0;
+    };
+    /// @brief requests the endpoints in parallel from the current mirror, the caller needs to hold the lock of the GET
+    /// request
+    /// @details An endpoint which is not answered within the p95 latency of the current mirror, or which fails, is
+    /// requested from the fastest other mirror as well. The first answer wins and the other request is cancelled.
+    /// The circuit breaker records a single result for all endpoints.
+    /// @param responseCodes receives the response codes, zero if no mirror answered
+    HedgeStatistics performHedged(const std::vector<std::string>& endpoints,
+                                  std::vector<ResponsePool::Lease>& responses, std::vector<long>& responseCodes);
+    /// @brief requests a single endpoint like performHedged, the caller needs to hold the lock of the GET request
+    /// @param responseCode the response code, zero if no mirror answered
+    /// @return the leased response, the buffer returns to the pool when the lease is destroyed
+    ResponsePool::Lease performGet(const std::string& endpointUrl, long& responseCode);
+    /// @brief sends a journaled write
+    /// @return true if the backend answered and the write can be acknowledged
+    bool send(const Outbox::Entry& entry);
+    /// @brief journals a write and sends it after the pending writes
+    void queueWrite(Outbox::Method method, const std::string& callsign, const std::string& endpointUrl,
+                    const std::string& message);
+    /// @brief sends an already serialized patch message to the specified endpoint url
+    void sendPatchBody(const std::string& endpointUrl, const std::string& callsign, const std::string& message);
 
    public:
+    /// @brief pilot fields which are only needed by single tag items
+    enum class OptionalField : std::uint32_t { EcfmpMeasures = 1, EventBooking = 2 };
+
     ~Server();
     Server(const Server&) = delete;
     Server(Server&&) = delete;
@@ -51,10 +131,30 @@ class Server {
 
     static Server& instance();
 
-    void changeServerAddress(const std::string& url);
+    /// @brief replaces the backend, the requests fail over to the mirrors if it does not answer
+    void changeServerAddress(const std::string& url, const std::vector<std::string>& mirrors = {});
+    /// @brief opens the write-ahead journal, writes which were not delivered in the last session are replayed
+    void openOutbox(const std::string& filename);
+    /// @brief sends the pending writes in order until one of them fails
+    void flushOutbox();
+    /// @brief returns the number of journaled writes which are not delivered yet
+    std::size_t pendingWrites();
     bool checkWebApi();
     ServerConfiguration_t getServerConfig();
+    /// @brief requests an optional field with the pilots from now on
+    void requireField(OptionalField field);
+    /// @brief requests the pilots departing from the airports, all pilots if the list is empty
     std::list<types::Pilot> getPilots(const std::list<std::string> airports);
+    /// @brief requests the unparsed pilots with all optional fields, used by the relay to serve its clients
+    /// @return true if the backend answered every chunk
+    bool getPilotsJson(const std::list<std::string>& airports, Json::Value& pilots);
+    /// @brief requests an endpoint of the backend without interpreting the response
+    /// @return true if the backend answered, the response code is set in this case
+    bool getDocument(const std::string& endpointUrl, std::string& response, long& responseCode);
+    /// @brief journals a write which was received by the relay, it is sent by the next call of flushOutbox
+    /// @return false if the writes are disabled, i.e. the backend is not checked or the client is no master
+    bool forwardWrite(Outbox::Method method, const std::string& callsign, const std::string& endpointUrl,
+                      const std::string& message);
     void postPilot(types::Pilot);
     void patchPilot(const Json::Value& root);
 
@@ -81,6 +181,12 @@ class Server {
     void deletePilot(const std::string& callsign);
 
     const std::string& errorMessage() const;
+    /// @brief returns the circuit breaker state of every endpoint as human readable messages
+    std::vector<std::string> breakerStatus();
+    /// @brief returns the state and the latencies of every mirror as human readable messages
+    std::vector<std::string> mirrorStatus();
+    /// @brief returns the transferred bytes of every endpoint as human readable messages
+    std::vector<std::string> transferStatus();
     void setMaster(bool master);
     bool getMaster();
 };
@@ -68,11 +68,10 @@ void vACDM::OnFunctionCall(int functionId, const char *itemString, POINT pt, REC
     if (false == Server::instance().getMaster()) return;
 
     auto flightplan = FlightPlanSelectASEL();
-    std::string callsign(flightplan.GetCallsign());
+    const auto data = DataManager::instance().getPilot(flightplan.GetCallsign());
+    if (false == data.has_value()) return;
 
-    if (false == DataManager::instance().checkPilotExists(callsign)) return;
-
-    auto pilot = DataManager::instance().getPilot(callsign);
+    const auto &pilot = data.value();
 
     switch (static_cast<itemFunction>(functionId)) {
         case EXOT_MODIFY:
@@ -7,6 +7,7 @@
 #include <string>
 
 #include "TagItemsColor.h"
+#include "core/Server.h"
 #include "types/Pilot.h"
 #include "vACDM.h"
 
@@ -68,11 +69,9 @@ void vACDM::OnGetTagItem(EuroScopePlugIn::CFlightPlan FlightPlan, EuroScopePlugI
     if (std::string_view("I") != FlightPlan.GetFlightPlanData().GetPlanType()) {
         return;
     }
-    std::string callsign = FlightPlan.GetCallsign();
+    if (false == DataManager::instance().readPilot(FlightPlan.GetCallsign(), this->m_tagItemPilot)) return;
 
-    if (false == DataManager::instance().checkPilotExists(callsign)) return;
-
-    auto pilot = DataManager::instance().getPilot(callsign);
+    const auto &pilot = this->m_tagItemPilot;
 
     std::stringstream outputText;
 
@@ -124,6 +123,7 @@ void vACDM::OnGetTagItem(EuroScopePlugIn::CFlightPlan FlightPlan, EuroScopePlugI
             *pRGB = Color::colorizeCtot(pilot);
             break;
         case itemType::ECFMP_MEASURES:
+            com::Server::instance().requireField(com::Server::OptionalField::EcfmpMeasures);
             if (false == pilot.measures.empty()) {
                 const std::int64_t measureMinutes = pilot.measures[0].value / 60;
                 const std::int64_t measureSeconds = pilot.measures[0].value % 60;
@@ -133,6 +133,7 @@ void vACDM::OnGetTagItem(EuroScopePlugIn::CFlightPlan FlightPlan, EuroScopePlugI
             }
             break;
         case itemType::EVENT_BOOKING:
+            com::Server::instance().requireField(com::Server::OptionalField::EventBooking);
             outputText << (pilot.hasBooking ? "B" : "");
             *pRGB = Color::colorizeEventBooking(pilot);
             break;
@@ -0,0 +1,67 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+using namespace vacdm::core;
+
+WorkerPool::WorkerPool(std::size_t threads) : m_pendingTasks(0), m_stop(false) {
+    for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i)
+        this->m_threads.emplace_back(&WorkerPool::work, this);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard guard(this->m_lock);
+        this->m_stop = true;
+    }
+    this->m_wakeup.notify_all();
+
+    for (auto &thread : this->m_threads) thread.join();
+}
+
+void WorkerPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock guard(this->m_lock);
+            this->m_wakeup.wait(guard, [this] { return true == this->m_stop || false == this->m_tasks.empty(); });
+            if (true == this->m_tasks.empty()) return;
+
+            task = std::move(this->m_tasks.front());
+            this->m_tasks.pop_front();
+        }
+
+        task();
+
+        std::lock_guard guard(this->m_lock);
+        this->m_pendingTasks -= 1;
+        if (0 == this->m_pendingTasks) this->m_finished.notify_all();
+    }
+}
+
+void WorkerPool::run(std::vector<std::function<void()>> tasks) {
+    if (true == tasks.empty()) return;
+
+    std::unique_lock guard(this->m_lock);
+    this->m_pendingTasks += tasks.size();
+    for (auto &task : tasks) this->m_tasks.push_back(std::move(task));
+    this->m_wakeup.notify_all();
+
+    this->m_finished.wait(guard, [this] { return 0 == this->m_pendingTasks; });
+}
+
+void WorkerPool::post(std::function<void()> task) {
+    {
+        std::lock_guard guard(this->m_lock);
+        this->m_pendingTasks += 1;
+        this->m_tasks.push_back(std::move(task));
+    }
+    this->m_wakeup.notify_one();
+}
+
+std::size_t WorkerPool::pending() {
+    std::lock_guard guard(this->m_lock);
+    return this->m_pendingTasks;
+}
+
+std::size_t WorkerPool::size() const { return this->m_threads.size(); }
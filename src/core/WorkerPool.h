@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vacdm::core {
+/// @brief small fixed-size thread pool that runs batches of independent tasks
+/// @details The queued tasks are finished before the pool is destroyed.
+class WorkerPool {
+   private:
+    std::vector<std::thread> m_threads;
+    std::mutex m_lock;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_finished;
+    std::deque<std::function<void()>> m_tasks;
+    std::size_t m_pendingTasks;
+    bool m_stop;
+
+    void work();
+
+   public:
+    /// @param threads the number of worker threads, at least one thread is created
+    explicit WorkerPool(std::size_t threads);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool(WorkerPool &&) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+    WorkerPool &operator=(WorkerPool &&) = delete;
+
+    /// @brief runs the tasks on the worker threads and blocks until all of them are finished
+    /// @details Tasks queued with post() before are part of the batch as well.
+    void run(std::vector<std::function<void()>> tasks);
+    /// @brief queues a task without waiting for it, a pool with one thread runs the tasks in order
+    void post(std::function<void()> task);
+    /// @brief returns the number of queued and running tasks
+    std::size_t pending();
+    std::size_t size() const;
+};
+}  // namespace vacdm::core
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+namespace vacdm::logging::binary {
+// Layout of the binary log files (.vacdmb), shared by the plugin and the host-side converter.
+//
+// The file starts with a FileHeader, followed by records. Each record starts with a RecordHeader and is followed by
+// payloadLength bytes of text. Records are padded to RecordAlignment, length contains the padding. The file is
+// preallocated with zeros, a record length of zero marks the end of the written data.
+//
+// Strings that repeat in every record (callsigns, airports, events, sender names) are written once as Symbol or
+// SenderName record and referenced by their id afterwards. The id 0 marks an empty field.
+
+static constexpr char FileMagic[8] = {'V', 'A', 'C', 'D', 'M', 'B', 'L', '\0'};
+static constexpr std::uint32_t FileVersion = 1;
+static constexpr std::uint32_t RecordAlignment = 8;
+
+enum class RecordType : std::uint8_t {
+    Message = 1,
+    Symbol = 2,
+    SenderName = 3,
+};
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    /// @brief bytes written after the header, updated after every batch
+    std::uint64_t usedBytes;
+};
+
+struct RecordHeader {
+    /// @brief total length of the record, including this header and the padding
+    std::uint32_t length;
+    RecordType type;
+    /// @brief the Logger::LogSender
+    std::uint8_t sender;
+    /// @brief the Logger::LogLevel
+    std::uint8_t level;
+    std::uint8_t reserved;
+    /// @brief milliseconds since the UNIX epoch (system clock)
+    std::int64_t timestamp;
+    /// @brief callsign symbol of a message, the id of the defined symbol of a Symbol record
+    std::uint32_t callsignId;
+    std::uint32_t airportId;
+    std::uint32_t eventId;
+    std::uint32_t payloadLength;
+};
+
+static_assert(sizeof(FileHeader) == 24);
+static_assert(sizeof(RecordHeader) == 32);
+
+static constexpr std::uint32_t recordLength(std::uint32_t payloadLength) {
+    const std::uint32_t length = static_cast<std::uint32_t>(sizeof(RecordHeader)) + payloadLength;
+    return (length + RecordAlignment - 1) / RecordAlignment * RecordAlignment;
+}
+}  // namespace vacdm::logging::binary
@@ -0,0 +1,214 @@
+#include "BinaryLogSink.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <cstring>
+
+using namespace vacdm::logging;
+
+// grow the file in large steps, every remap stalls the writer thread
+static constexpr std::uint64_t __preallocatedBytes = 64ull * 1024ull * 1024ull;
+
+#ifdef _WIN32
+BinaryLogSink::BinaryLogSink()
+    : m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr), m_view(nullptr), m_capacity(0), m_offset(0), m_symbols() {}
+#else
+BinaryLogSink::BinaryLogSink() : m_file(-1), m_view(nullptr), m_capacity(0), m_offset(0), m_symbols() {}
+#endif
+
+BinaryLogSink::~BinaryLogSink() { this->close(); }
+
+bool BinaryLogSink::open(const std::string &filename) {
+    this->close();
+
+#ifdef _WIN32
+    this->m_file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == this->m_file) return false;
+#else
+    this->m_file = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (-1 == this->m_file) return false;
+#endif
+
+    if (false == this->map(__preallocatedBytes)) {
+        this->close();
+        return false;
+    }
+
+    binary::FileHeader header{};
+    std::memcpy(header.magic, binary::FileMagic, sizeof(header.magic));
+    header.version = binary::FileVersion;
+    header.headerSize = sizeof(binary::FileHeader);
+    header.usedBytes = 0;
+    std::memcpy(this->m_view, &header, sizeof(header));
+    this->m_offset = sizeof(binary::FileHeader);
+
+    return true;
+}
+
+void BinaryLogSink::close() {
+    if (nullptr != this->m_view) {
+        this->flush();
+        this->writeBack();
+    }
+    this->unmap();
+
+#ifdef _WIN32
+    if (INVALID_HANDLE_VALUE != this->m_file) {
+        // drop the unused preallocated space
+        LARGE_INTEGER size;
+        size.QuadPart = static_cast<LONGLONG>(this->m_offset);
+        SetFilePointerEx(this->m_file, size, nullptr, FILE_BEGIN);
+        SetEndOfFile(this->m_file);
+
+        CloseHandle(this->m_file);
+        this->m_file = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (-1 != this->m_file) {
+        // drop the unused preallocated space, the readers stop at the used size of the header if this fails
+        [[maybe_unused]] const auto truncated = ::ftruncate(this->m_file, static_cast<off_t>(this->m_offset));
+        ::close(this->m_file);
+        this->m_file = -1;
+    }
+#endif
+
+    this->m_capacity = 0;
+    this->m_offset = 0;
+    this->m_symbols.clear();
+}
+
+bool BinaryLogSink::isOpen() const { return nullptr != this->m_view; }
+
+#ifdef _WIN32
+bool BinaryLogSink::map(std::uint64_t capacity) {
+    // creating the mapping extends the file to the requested capacity, the new pages are zero-initialized
+    this->m_mapping = CreateFileMappingA(this->m_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(capacity >> 32),
+                                         static_cast<DWORD>(capacity & 0xffffffffull), nullptr);
+    if (nullptr == this->m_mapping) return false;
+
+    this->m_view = static_cast<char *>(MapViewOfFile(this->m_mapping, FILE_MAP_WRITE, 0, 0, 0));
+    if (nullptr == this->m_view) {
+        CloseHandle(this->m_mapping);
+        this->m_mapping = nullptr;
+        return false;
+    }
+
+    this->m_capacity = capacity;
+    return true;
+}
+
+void BinaryLogSink::unmap() {
+    if (nullptr != this->m_view) {
+        UnmapViewOfFile(this->m_view);
+        this->m_view = nullptr;
+    }
+    if (nullptr != this->m_mapping) {
+        CloseHandle(this->m_mapping);
+        this->m_mapping = nullptr;
+    }
+}
+
+void BinaryLogSink::writeBack() { FlushViewOfFile(this->m_view, 0); }
+#else
+bool BinaryLogSink::map(std::uint64_t capacity) {
+    // extending the file zero-initializes the new pages
+    if (0 != ::ftruncate(this->m_file, static_cast<off_t>(capacity))) return false;
+
+    void *view = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, this->m_file, 0);
+    if (MAP_FAILED == view) return false;
+
+    this->m_view = static_cast<char *>(view);
+    this->m_capacity = capacity;
+    return true;
+}
+
+void BinaryLogSink::unmap() {
+    if (nullptr != this->m_view) {
+        ::munmap(this->m_view, this->m_capacity);
+        this->m_view = nullptr;
+    }
+}
+
+void BinaryLogSink::writeBack() { ::msync(this->m_view, this->m_offset, MS_SYNC); }
+#endif
+
+bool BinaryLogSink::reserve(std::uint32_t length) {
+    // keep space for the terminating zero length
+    if (this->m_offset + length + sizeof(std::uint32_t) <= this->m_capacity) return true;
+
+    this->flush();
+    this->writeBack();
+    this->unmap();
+
+    // grow in whole preallocation steps until the record fits, a single message may exceed one step
+    auto capacity = this->m_capacity + __preallocatedBytes;
+    while (this->m_offset + length + sizeof(std::uint32_t) > capacity) capacity += __preallocatedBytes;
+    return this->map(capacity);
+}
+
+void BinaryLogSink::append(binary::RecordHeader header, std::string_view payload) {
+    if (nullptr == this->m_view) return;
+
+    header.payloadLength = static_cast<std::uint32_t>(payload.size());
+    header.length = binary::recordLength(header.payloadLength);
+    if (false == this->reserve(header.length)) return;
+
+    // the padding is already zero due to the preallocation
+    char *record = this->m_view + this->m_offset;
+    std::memcpy(record + sizeof(header), payload.data(), payload.size());
+    std::memcpy(record, &header, sizeof(header));
+    this->m_offset += header.length;
+}
+
+std::uint32_t BinaryLogSink::symbol(const std::string &value) {
+    if (true == value.empty()) return 0;
+
+    const auto it = this->m_symbols.find(value);
+    if (this->m_symbols.end() != it) return it->second;
+
+    const auto id = static_cast<std::uint32_t>(this->m_symbols.size() + 1);
+    this->m_symbols.emplace(value, id);
+
+    binary::RecordHeader header{};
+    header.type = binary::RecordType::Symbol;
+    header.callsignId = id;
+    this->append(header, value);
+
+    return id;
+}
+
+void BinaryLogSink::defineSender(std::uint8_t sender, const std::string &name) {
+    binary::RecordHeader header{};
+    header.type = binary::RecordType::SenderName;
+    header.sender = sender;
+    this->append(header, name);
+}
+
+void BinaryLogSink::write(std::int64_t timestamp, std::uint8_t sender, std::uint8_t level,
+                          const std::string &callsign, const std::string &airport, const std::string &event,
+                          const std::string &message) {
+    binary::RecordHeader header{};
+    header.type = binary::RecordType::Message;
+    header.sender = sender;
+    header.level = level;
+    header.timestamp = timestamp;
+    header.callsignId = this->symbol(callsign);
+    header.airportId = this->symbol(airport);
+    header.eventId = this->symbol(event);
+    this->append(header, message);
+}
+
+void BinaryLogSink::flush() {
+    if (nullptr == this->m_view) return;
+
+    const std::uint64_t usedBytes = this->m_offset - sizeof(binary::FileHeader);
+    std::memcpy(this->m_view + offsetof(binary::FileHeader, usedBytes), &usedBytes, sizeof(usedBytes));
+}
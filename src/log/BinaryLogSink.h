@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "log/BinaryLogFormat.h"
+
+namespace vacdm::logging {
+/// @brief append-only binary log file, written through a preallocated memory-mapped view
+/// @details The sink is not thread-safe, it is only used by the writer thread of the Logger. Use the
+/// vacdm-logconvert tool to export a binary log to the SQLite schema.
+class BinaryLogSink {
+   private:
+#ifdef _WIN32
+    void *m_file;
+    void *m_mapping;
+#else
+    int m_file;
+#endif
+    char *m_view;
+    std::uint64_t m_capacity;
+    std::uint64_t m_offset;
+    std::unordered_map<std::string, std::uint32_t> m_symbols;
+
+    bool map(std::uint64_t capacity);
+    void unmap();
+    /// @brief writes the modified pages of the view back to the file
+    void writeBack();
+    bool reserve(std::uint32_t length);
+    std::uint32_t symbol(const std::string &value);
+    void append(binary::RecordHeader header, std::string_view payload);
+
+   public:
+    BinaryLogSink();
+    ~BinaryLogSink();
+    BinaryLogSink(const BinaryLogSink &) = delete;
+    BinaryLogSink(BinaryLogSink &&) = delete;
+    BinaryLogSink &operator=(const BinaryLogSink &) = delete;
+    BinaryLogSink &operator=(BinaryLogSink &&) = delete;
+
+    /// @brief creates and preallocates the log file
+    /// @param filename the file to create, an existing file is replaced
+    /// @return true if the file is mapped and ready to be written
+    bool open(const std::string &filename);
+    /// @brief flushes the view and truncates the file to the written size
+    void close();
+    bool isOpen() const;
+
+    /// @brief defines the name of a sender, needs to be called once per sender before writing its messages
+    void defineSender(std::uint8_t sender, const std::string &name);
+    /// @brief appends a message record
+    /// @param timestamp milliseconds since the UNIX epoch
+    void write(std::int64_t timestamp, std::uint8_t sender, std::uint8_t level, const std::string &callsign,
+               const std::string &airport, const std::string &event, const std::string &message);
+    /// @brief publishes the written size in the file header, the pages are written back by the OS
+    void flush();
+};
+}  // namespace vacdm::logging
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace vacdm::logging {
+/// @brief schema of the .vacdm log files, shared by the plugin and the host-side log tools
+/// @details callsign, airport and event are stored in separate indexed columns to avoid full-table scans when
+/// searching for everything that happened to a single flight or airport during an event
+static const char __loggingTable[] =
+    "CREATE TABLE IF NOT EXISTS messages( \
+    timestamp TIMESTAMP DEFAULT CURRENT_TIMESTAMP, \
+    sender TEXT, \
+    level INT, \
+    callsign TEXT, \
+    airport TEXT, \
+    event TEXT, \
+    message TEXT \
+);";
+
+static const char __loggingIndices[] =
+    "CREATE INDEX IF NOT EXISTS messages_timestamp ON messages(timestamp); \
+    CREATE INDEX IF NOT EXISTS messages_callsign ON messages(callsign, timestamp); \
+    CREATE INDEX IF NOT EXISTS messages_airport ON messages(airport, timestamp); \
+    CREATE INDEX IF NOT EXISTS messages_event ON messages(event, timestamp); \
+    CREATE INDEX IF NOT EXISTS messages_level ON messages(level, timestamp);";
+
+static const char __insertMessage[] = "INSERT INTO messages VALUES (@1, @2, @3, @4, @5, @6, @7)";
+}  // namespace vacdm::logging
@@ -1,7 +1,9 @@
 #include "Logger.h"
 
 #ifdef DEBUG_BUILD
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 #include <iostream>
 #endif
@@ -10,29 +12,25 @@
 #include <chrono>
 #include <numeric>
 
+#include "log/LogSchema.h"
 #include "utils/String.h"
 
 using namespace std::chrono_literals;
 using namespace vacdm::logging;
 
-static const char __loggingTable[] =
-    "CREATE TABLE messages( \
-    timestamp TIMESTAMP DEFAULT CURRENT_TIMESTAMP, \
-    sender TEXT, \
-    level INT, \
-    message TEXT \
-);";
-static const std::string __insertMessage = "INSERT INTO messages VALUES (CURRENT_TIMESTAMP, @1, @2, @3)";
-
-Logger::Logger() {
-    stream << std::format("{0:%Y%m%d%H%M%S}", std::chrono::utc_clock::now()) << ".vacdm";
+static constexpr auto __limitSummaryInterval = 60s;
+
+Logger::Logger() : m_lastLimitSummary(std::chrono::steady_clock::now()) {
+    stream << std::format("{0:%Y%m%d%H%M%S}", std::chrono::utc_clock::now());
 #ifdef DEBUG_BUILD
+#ifdef _WIN32
     AllocConsole();
 #pragma warning(push)
 #pragma warning(disable : 6031)
     freopen("CONOUT$", "w", stdout);
     freopen("CONOUT$", "w", stderr);
 #pragma warning(pop)
+#endif
     this->enableLogging();
 #endif
     this->m_logWriter = std::thread(&Logger::run, this);
@@ -52,10 +50,27 @@ void Logger::run() {
 
         // obtain a copy of the logs, clear the log list to minimize lock time
         this->m_logLock.lock();
+        if (std::chrono::steady_clock::now() - this->m_lastLimitSummary >= __limitSummaryInterval)
+            this->summarizeLimitedCallSites();
         auto logs = m_asynchronousLogs;
         m_asynchronousLogs.clear();
+        const auto backend = this->m_backend;
         this->m_logLock.unlock();
 
+        if (true == logs.empty()) continue;
+
+        // the log files are created by the writer thread to keep the file handling out of the EuroScope thread
+        sqlite3_stmt *stmt = nullptr;
+        if (LogBackend::Binary == backend) {
+            if (false == this->m_binaryLogFileCreated) this->createBinaryLogFile();
+        } else {
+            if (false == this->logFileCreated) this->createLogFile();
+
+            // one statement and one transaction per batch, the indices make single inserts expensive
+            sqlite3_exec(this->m_database, "BEGIN TRANSACTION", nullptr, nullptr, nullptr);
+            sqlite3_prepare_v2(this->m_database, __insertMessage, sizeof(__insertMessage) - 1, &stmt, nullptr);
+        }
+
         auto it = logs.begin();
         while (it != logs.end()) {
             auto logsetting = std::find_if(logSettings.begin(), logSettings.end(),
@@ -67,31 +82,125 @@ void Logger::run() {
                 std::cout << logsetting->name << ": " << it->message << "\n";
 #endif
 
-                sqlite3_stmt *stmt;
-
-                sqlite3_prepare_v2(this->m_database, __insertMessage.c_str(), __insertMessage.length(), &stmt, nullptr);
-                sqlite3_bind_text(stmt, 1, logsetting->name.c_str(), -1, SQLITE_TRANSIENT);
-                sqlite3_bind_int(stmt, 2, static_cast<int>(it->loglevel));
-                sqlite3_bind_text(stmt, 3, it->message.c_str(), -1, SQLITE_TRANSIENT);
-
-                sqlite3_step(stmt);
-                sqlite3_clear_bindings(stmt);
-                sqlite3_reset(stmt);
+                if (LogBackend::Binary == backend) {
+                    const auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::utc_clock::to_sys(it->timestamp).time_since_epoch());
+
+                    this->m_binarySink.write(timestamp.count(), static_cast<std::uint8_t>(it->sender),
+                                             static_cast<std::uint8_t>(it->loglevel), it->context.callsign,
+                                             it->context.airport, it->context.event, it->message);
+                } else {
+                    // same layout as CURRENT_TIMESTAMP, extended by milliseconds to keep range queries precise
+                    const auto timestamp = std::format(
+                        "{0:%F %T}", std::chrono::time_point_cast<std::chrono::milliseconds>(it->timestamp));
+
+                    sqlite3_bind_text(stmt, 1, timestamp.c_str(), -1, SQLITE_TRANSIENT);
+                    sqlite3_bind_text(stmt, 2, logsetting->name.c_str(), -1, SQLITE_TRANSIENT);
+                    sqlite3_bind_int(stmt, 3, static_cast<int>(it->loglevel));
+                    Logger::bindOptionalText(stmt, 4, it->context.callsign);
+                    Logger::bindOptionalText(stmt, 5, it->context.airport);
+                    Logger::bindOptionalText(stmt, 6, it->context.event);
+                    sqlite3_bind_text(stmt, 7, it->message.c_str(), -1, SQLITE_TRANSIENT);
+
+                    sqlite3_step(stmt);
+                    sqlite3_clear_bindings(stmt);
+                    sqlite3_reset(stmt);
+                }
             }
             it = logs.erase(it);
         }
+
+        if (LogBackend::Binary == backend) {
+            this->m_binarySink.flush();
+        } else {
+            sqlite3_finalize(stmt);
+            sqlite3_exec(this->m_database, "COMMIT", nullptr, nullptr, nullptr);
+        }
     }
 }
 
-void Logger::log(const LogSender &sender, const std::string &message, const LogLevel loglevel) {
+void Logger::bindOptionalText(sqlite3_stmt *stmt, int index, const std::string &value) {
+    // store empty fields as NULL, keeps the indices small and allows "IS NULL" queries
+    if (true == value.empty())
+        sqlite3_bind_null(stmt, index);
+    else
+        sqlite3_bind_text(stmt, index, value.c_str(), -1, SQLITE_TRANSIENT);
+}
+
+void Logger::log(const LogSender &sender, const std::string &message, const LogLevel loglevel,
+                 const LogContext &context) {
     std::lock_guard guard(this->m_logLock);
-    if (true == this->loggingEnabled) m_asynchronousLogs.push_back({sender, message, loglevel});
+    if (true == this->loggingEnabled)
+        m_asynchronousLogs.push_back({sender, message, loglevel, context, std::chrono::utc_clock::now()});
+}
+
+void Logger::logLimited(const LogSender &sender, const std::string &callSite, const LogLimit &limit,
+                        const std::string &message, const LogLevel loglevel, const LogContext &context) {
+    std::lock_guard guard(this->m_logLock);
+    if (false == this->loggingEnabled) return;
+
+    if (true == this->passesLimit(sender, callSite, limit, context.callsign))
+        m_asynchronousLogs.push_back({sender, message, loglevel, context, std::chrono::utc_clock::now()});
+}
+
+bool Logger::passesLimit(const LogSender &sender, const std::string &callSite, const LogLimit &limit,
+                         const std::string &key) {
+    auto &site = this->m_limitedCallSites[callSite];
+    site.sender = sender;
+    site.calls += 1;
+
+    // sampling: keep the first message and every sampleRate-th after it
+    if (limit.sampleRate > 1 && (site.calls - 1) % limit.sampleRate != 0) {
+        site.suppressed += 1;
+        return false;
+    }
+
+    // rate limiting per key
+    if (limit.interval.count() > 0) {
+        const auto now = std::chrono::steady_clock::now();
+        auto it = site.lastLogged.find(key);
+        if (site.lastLogged.end() != it && now - it->second < limit.interval) {
+            site.suppressed += 1;
+            return false;
+        }
+
+        if (site.lastLogged.end() == it)
+            site.lastLogged.emplace(key, now);
+        else
+            it->second = now;
+    }
+
+    return true;
+}
+
+void Logger::summarizeLimitedCallSites() {
+    const auto now = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(now - this->m_lastLimitSummary).count();
+
+    for (auto &[name, site] : this->m_limitedCallSites) {
+        if (0 != site.suppressed) {
+            m_asynchronousLogs.push_back({site.sender,
+                                          "Suppressed " + std::to_string(site.suppressed) + " of " +
+                                              std::to_string(site.calls) + " messages of " + name + " in the last " +
+                                              std::to_string(seconds) + " seconds",
+                                          LogLevel::Info,
+                                          {"", "", "LogSummary"},
+                                          std::chrono::utc_clock::now()});
+        }
+        site.calls = 0;
+        site.suppressed = 0;
+
+        // forget keys which are not rate limited anymore, e.g. disconnected flights
+        std::erase_if(site.lastLogged, [&now](const auto &entry) { return now - entry.second > 10min; });
+    }
+
+    this->m_lastLimitSummary = now;
 }
 
 std::string Logger::handleLogCommand(std::string command) {
     auto elements = vacdm::utils::String::splitString(command, " ");
 
-    std::string usageString = "Usage: .vacdm LOG ON/OFF/DEBUG";
+    std::string usageString = "Usage: .vacdm LOG ON/OFF/DEBUG/SQLITE/BINARY";
     if (elements.size() != 3) return usageString;
 
     if ("ON" == elements[2]) {
@@ -100,6 +209,14 @@ std::string Logger::handleLogCommand(std::string command) {
     } else if ("OFF" == elements[2]) {
         this->disableLogging();
         return "Disabled logging";
+    } else if ("SQLITE" == elements[2]) {
+        std::lock_guard guard(this->m_logLock);
+        this->m_backend = LogBackend::Sqlite;
+        return "Writing logs to " + stream.str() + ".vacdm";
+    } else if ("BINARY" == elements[2]) {
+        std::lock_guard guard(this->m_logLock);
+        this->m_backend = LogBackend::Binary;
+        return "Writing logs to " + stream.str() + ".vacdmb";
     } else if ("DEBUG" == elements[2]) {
         std::lock_guard guard(this->m_logLock);
         if (false == this->m_LogAll) {
@@ -180,8 +297,6 @@ std::string Logger::handleLogLevelCommand(std::string command) {
 }
 
 void Logger::enableLogging() {
-    if (false == this->logFileCreated) createLogFile();
-
     std::lock_guard guard(this->m_logLock);
     this->loggingEnabled = true;
 }
@@ -192,12 +307,21 @@ void Logger::disableLogging() {
 }
 
 void Logger::createLogFile() {
-    sqlite3_open(stream.str().c_str(), &this->m_database);
+    sqlite3_open((stream.str() + ".vacdm").c_str(), &this->m_database);
     sqlite3_exec(this->m_database, __loggingTable, nullptr, nullptr, nullptr);
+    sqlite3_exec(this->m_database, __loggingIndices, nullptr, nullptr, nullptr);
     sqlite3_exec(this->m_database, "PRAGMA journal_mode = MEMORY", nullptr, nullptr, nullptr);
     logFileCreated = true;
 }
 
+void Logger::createBinaryLogFile() {
+    if (true == this->m_binarySink.open(stream.str() + ".vacdmb")) {
+        for (const auto &setting : std::as_const(this->logSettings))
+            this->m_binarySink.defineSender(static_cast<std::uint8_t>(setting.sender), setting.name);
+    }
+    m_binaryLogFileCreated = true;
+}
+
 Logger &Logger::instance() {
     static Logger __instance;
     return __instance;
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <chrono>
 #include <list>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include "log/BinaryLogSink.h"
 #include "sqlite3.h"
 
 namespace vacdm::logging {
@@ -35,10 +39,35 @@ class Logger {
         LogLevel minimumLevel;
     };
 
+    /// @brief storage of the log messages
+    /// @details SQLite writes the .vacdm files which can be queried directly, the binary backend appends to a
+    /// memory-mapped .vacdmb file and is meant for high-volume DEBUG sessions (export it with vacdm-logconvert)
+    enum class LogBackend {
+        Sqlite,
+        Binary,
+    };
+
+    /// @brief structured fields of a log message, stored in separate indexed columns
+    struct LogContext {
+        std::string callsign;
+        std::string airport;
+        std::string event;
+    };
+
+    /// @brief limits the number of messages of a single call site
+    /// @details interval limits the messages per key (the callsign of the context) to one per interval, sampleRate logs
+    /// only every n-th message of the call site. Suppressed messages are summarized periodically.
+    struct LogLimit {
+        std::chrono::milliseconds interval = std::chrono::milliseconds(0);
+        std::uint32_t sampleRate = 1;
+    };
+
     struct AsynchronousLog {
         LogSender sender;
         std::string message;
         LogLevel loglevel;
+        LogContext context;
+        std::chrono::utc_clock::time_point timestamp;
     };
 
    private:
@@ -59,6 +88,20 @@ class Logger {
 #endif
     bool m_LogAll = false;
 
+    struct LimitedCallSite {
+        LogSender sender;
+        std::uint64_t calls = 0;
+        std::uint64_t suppressed = 0;
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> lastLogged;
+    };
+    std::unordered_map<std::string, LimitedCallSite> m_limitedCallSites;
+    std::chrono::steady_clock::time_point m_lastLimitSummary;
+    /// @brief checks if a message of a rate-limited call site passes its limit, requires m_logLock
+    bool passesLimit(const LogSender &sender, const std::string &callSite, const LogLimit &limit,
+                     const std::string &key);
+    /// @brief creates the summary messages of the suppressed messages per call site, requires m_logLock
+    void summarizeLimitedCallSites();
+
     std::mutex m_logLock;
     std::list<struct AsynchronousLog> m_asynchronousLogs;
     std::thread m_logWriter;
@@ -69,10 +112,16 @@ class Logger {
     void disableLogging();
     bool loggingEnabled = false;
 
-    sqlite3 *m_database;
+    LogBackend m_backend = LogBackend::Sqlite;
+    BinaryLogSink m_binarySink;
+    bool m_binaryLogFileCreated = false;
+    void createBinaryLogFile();
+
+    sqlite3 *m_database = nullptr;
     std::stringstream stream;
     bool logFileCreated = false;
     void createLogFile();
+    static void bindOptionalText(sqlite3_stmt *stmt, int index, const std::string &value);
 
    public:
     ~Logger();
@@ -80,7 +129,18 @@ class Logger {
     /// @param sender the sender (e.g. class)
     /// @param message the message to be displayed
     /// @param loglevel the severity, must be greater than m_minimumLogLevel to be logged
-    void log(const LogSender &sender, const std::string &message, const LogLevel loglevel);
+    /// @param context optional structured fields (callsign, airport, event type) of the message
+    void log(const LogSender &sender, const std::string &message, const LogLevel loglevel,
+             const LogContext &context = {});
+    /// @brief queues a log message of a high-volume call site (e.g. per pilot and update cycle)
+    /// @param sender the sender (e.g. class)
+    /// @param callSite unique name of the call site, used to group the limits and the summaries
+    /// @param limit the rate limit and sampling of the call site
+    /// @param message the message to be displayed
+    /// @param loglevel the severity, must be greater than m_minimumLogLevel to be logged
+    /// @param context optional structured fields, the callsign is used as the key of the rate limit
+    void logLimited(const LogSender &sender, const std::string &callSite, const LogLimit &limit,
+                    const std::string &message, const LogLevel loglevel, const LogContext &context = {});
     std::string handleLogCommand(std::string command);
     std::string handleLogLevelCommand(std::string command);
     static Logger &instance();
@@ -0,0 +1,157 @@
+/*
+ * @brief Command line tool to export binary log files (.vacdmb) to the SQLite schema of the .vacdm files
+ * @details The exported file can be analysed with vacdm-logquery or any SQLite client.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "log/BinaryLogFormat.h"
+#include "log/LogSchema.h"
+#include "log/sqlite3.h"
+
+using namespace vacdm::logging;
+
+namespace {
+std::string formatTimestamp(std::int64_t milliseconds) {
+    const std::time_t seconds = static_cast<std::time_t>(milliseconds / 1000);
+    const std::tm *utc = std::gmtime(&seconds);
+    if (nullptr == utc) return "";
+
+    // same layout as the timestamps written by the SQLite backend, sized for the widest int of every field
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d %02d:%02d:%02d.%03d", utc->tm_year + 1900, utc->tm_mon + 1,
+                  utc->tm_mday, utc->tm_hour, utc->tm_min, utc->tm_sec, static_cast<int>(milliseconds % 1000));
+    return buffer;
+}
+
+void bindSymbol(sqlite3_stmt *stmt, int index, const std::unordered_map<std::uint32_t, std::string> &symbols,
+                std::uint32_t id) {
+    const auto it = symbols.find(id);
+    if (0 == id || symbols.end() == it)
+        sqlite3_bind_null(stmt, index);
+    else
+        sqlite3_bind_text(stmt, index, it->second.c_str(), -1, SQLITE_STATIC);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <logfile.vacdmb> <output.vacdm>\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream stream(argv[1], std::ios::binary);
+    if (false == stream.is_open()) {
+        std::cerr << "Unable to open " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+    const std::vector<char> content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    binary::FileHeader fileHeader;
+    if (content.size() < sizeof(fileHeader)) {
+        std::cerr << argv[1] << " is not a binary vACDM log\n";
+        return EXIT_FAILURE;
+    }
+    std::memcpy(&fileHeader, content.data(), sizeof(fileHeader));
+    if (0 != std::memcmp(fileHeader.magic, binary::FileMagic, sizeof(fileHeader.magic)) ||
+        binary::FileVersion != fileHeader.version) {
+        std::cerr << argv[1] << " is not a binary vACDM log or has an unsupported version\n";
+        return EXIT_FAILURE;
+    }
+    if (fileHeader.headerSize < sizeof(fileHeader) || fileHeader.headerSize > content.size()) {
+        std::cerr << argv[1] << " has a corrupt header\n";
+        return EXIT_FAILURE;
+    }
+
+    // records after the used bytes were not flushed by the plugin, a truncated file ends before them
+    std::uint64_t end = content.size();
+    if (fileHeader.usedBytes < content.size() - fileHeader.headerSize)
+        end = fileHeader.headerSize + fileHeader.usedBytes;
+    else if (fileHeader.usedBytes > content.size() - fileHeader.headerSize)
+        std::cerr << argv[1] << " is truncated, converting the available records\n";
+
+    sqlite3 *database = nullptr;
+    if (SQLITE_OK != sqlite3_open(argv[2], &database)) {
+        std::cerr << "Unable to create " << argv[2] << ": " << sqlite3_errmsg(database) << "\n";
+        sqlite3_close_v2(database);
+        return EXIT_FAILURE;
+    }
+    sqlite3_exec(database, __loggingTable, nullptr, nullptr, nullptr);
+    sqlite3_exec(database, "BEGIN TRANSACTION", nullptr, nullptr, nullptr);
+
+    sqlite3_stmt *stmt = nullptr;
+    sqlite3_prepare_v2(database, __insertMessage, sizeof(__insertMessage) - 1, &stmt, nullptr);
+
+    std::unordered_map<std::uint32_t, std::string> symbols;
+    std::unordered_map<std::uint8_t, std::string> senders;
+    std::size_t messages = 0;
+
+    std::uint64_t offset = fileHeader.headerSize;
+    while (offset + sizeof(binary::RecordHeader) <= end) {
+        binary::RecordHeader header;
+        std::memcpy(&header, content.data() + offset, sizeof(header));
+
+        // a zero length marks the end of the written data, everything else needs to fit into the used bytes
+        if (0 == header.length) break;
+        if (header.length < sizeof(header) || offset + header.length > end ||
+            sizeof(header) + static_cast<std::uint64_t>(header.payloadLength) > header.length) {
+            std::cerr << "Truncated record at offset " << offset << ", stopping\n";
+            break;
+        }
+
+        const std::string payload(content.data() + offset + sizeof(header), header.payloadLength);
+        switch (header.type) {
+            case binary::RecordType::Symbol:
+                symbols[header.callsignId] = payload;
+                break;
+            case binary::RecordType::SenderName:
+                senders[header.sender] = payload;
+                break;
+            case binary::RecordType::Message: {
+                const auto timestamp = formatTimestamp(header.timestamp);
+                const auto sender = senders.find(header.sender);
+
+                sqlite3_bind_text(stmt, 1, timestamp.c_str(), -1, SQLITE_TRANSIENT);
+                if (senders.end() != sender)
+                    sqlite3_bind_text(stmt, 2, sender->second.c_str(), -1, SQLITE_TRANSIENT);
+                else
+                    sqlite3_bind_text(stmt, 2, std::to_string(header.sender).c_str(), -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(stmt, 3, header.level);
+                bindSymbol(stmt, 4, symbols, header.callsignId);
+                bindSymbol(stmt, 5, symbols, header.airportId);
+                bindSymbol(stmt, 6, symbols, header.eventId);
+                sqlite3_bind_text(stmt, 7, payload.c_str(), -1, SQLITE_TRANSIENT);
+
+                sqlite3_step(stmt);
+                sqlite3_clear_bindings(stmt);
+                sqlite3_reset(stmt);
+                messages += 1;
+                break;
+            }
+            default:
+                break;
+        }
+
+        offset += header.length;
+    }
+
+    sqlite3_finalize(stmt);
+    sqlite3_exec(database, "COMMIT", nullptr, nullptr, nullptr);
+
+    // create the indices after the bulk insert
+    sqlite3_exec(database, __loggingIndices, nullptr, nullptr, nullptr);
+    sqlite3_close_v2(database);
+
+    std::cerr << "Exported " << messages << " messages to " << argv[2] << "\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/*
+ * @brief Command line tool to query .vacdm log files
+ * @details Uses the indexed callsign, airport, event, level and timestamp columns of the messages table.
+ * The tool has no EuroScope dependencies and can be built on Linux to analyse logs after an event.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "log/sqlite3.h"
+
+namespace {
+// same order as vacdm::logging::Logger::LogLevel
+const char *__levelNames[] = {"DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL", "SYSTEM"};
+constexpr int __levelCount = sizeof(__levelNames) / sizeof(__levelNames[0]);
+
+struct QueryOptions {
+    std::string filename;
+    std::string callsign;
+    std::string airport;
+    std::string event;
+    std::string from;
+    std::string to;
+    int minimumLevel = -1;
+    int limit = -1;
+};
+
+void printUsage(const char *executable) {
+    std::cerr << "Usage: " << executable << " <logfile.vacdm> [options]\n"
+              << "  --callsign CALLSIGN   messages of a single flight\n"
+              << "  --airport ICAO        messages of a single airport\n"
+              << "  --event EVENT         messages of a single event type\n"
+              << "  --level LEVEL         minimum level (DEBUG, INFO, WARNING, ERROR, CRITICAL, SYSTEM or 0-5)\n"
+              << "  --from TIMESTAMP      first timestamp, e.g. \"2024-01-01 18:00:00\"\n"
+              << "  --to TIMESTAMP        last timestamp, e.g. \"2024-01-01 21:00:00\"\n"
+              << "  --limit N             maximum number of printed messages\n";
+}
+
+int parseLevel(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    for (int i = 0; i < __levelCount; ++i) {
+        if (value == __levelNames[i]) return i;
+    }
+
+    char *end = nullptr;
+    const long level = std::strtol(value.c_str(), &end, 10);
+    if (end == value.c_str() || *end != '\0' || level < 0 || level >= __levelCount) return -1;
+    return static_cast<int>(level);
+}
+
+bool parseArguments(int argc, char **argv, QueryOptions &options) {
+    if (argc < 2 || argv[1][0] == '-') return false;
+    options.filename = argv[1];
+
+    for (int i = 2; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (i + 1 >= argc) return false;
+        const std::string value = argv[++i];
+
+        if ("--callsign" == argument) {
+            options.callsign = value;
+        } else if ("--airport" == argument) {
+            options.airport = value;
+        } else if ("--event" == argument) {
+            options.event = value;
+        } else if ("--from" == argument) {
+            options.from = value;
+        } else if ("--to" == argument) {
+            options.to = value;
+        } else if ("--level" == argument) {
+            options.minimumLevel = parseLevel(value);
+            if (options.minimumLevel < 0) return false;
+        } else if ("--limit" == argument) {
+            options.limit = std::atoi(value.c_str());
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const char *columnText(sqlite3_stmt *stmt, int column) {
+    const auto text = sqlite3_column_text(stmt, column);
+    return nullptr != text ? reinterpret_cast<const char *>(text) : "";
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    QueryOptions options;
+    if (false == parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    sqlite3 *database = nullptr;
+    if (SQLITE_OK != sqlite3_open_v2(options.filename.c_str(), &database, SQLITE_OPEN_READONLY, nullptr)) {
+        std::cerr << "Unable to open " << options.filename << ": " << sqlite3_errmsg(database) << "\n";
+        sqlite3_close_v2(database);
+        return EXIT_FAILURE;
+    }
+
+    // every filter maps to an indexed column, the parameters are bound in the order of the conditions
+    std::string query = "SELECT timestamp, sender, level, callsign, airport, event, message FROM messages";
+    std::vector<std::string> conditions, parameters;
+    if (false == options.callsign.empty()) {
+        conditions.push_back("callsign = ?");
+        parameters.push_back(options.callsign);
+    }
+    if (false == options.airport.empty()) {
+        conditions.push_back("airport = ?");
+        parameters.push_back(options.airport);
+    }
+    if (false == options.event.empty()) {
+        conditions.push_back("event = ?");
+        parameters.push_back(options.event);
+    }
+    if (false == options.from.empty()) {
+        conditions.push_back("timestamp >= ?");
+        parameters.push_back(options.from);
+    }
+    if (false == options.to.empty()) {
+        conditions.push_back("timestamp <= ?");
+        parameters.push_back(options.to);
+    }
+    if (options.minimumLevel >= 0) conditions.push_back("level >= " + std::to_string(options.minimumLevel));
+
+    for (std::size_t i = 0; i < conditions.size(); ++i) query += (0 == i ? " WHERE " : " AND ") + conditions[i];
+    query += " ORDER BY timestamp";
+    if (options.limit > 0) query += " LIMIT " + std::to_string(options.limit);
+
+    sqlite3_stmt *stmt = nullptr;
+    if (SQLITE_OK != sqlite3_prepare_v2(database, query.c_str(), -1, &stmt, nullptr)) {
+        std::cerr << "Invalid log file " << options.filename << ": " << sqlite3_errmsg(database) << "\n";
+        sqlite3_close_v2(database);
+        return EXIT_FAILURE;
+    }
+
+    for (std::size_t i = 0; i < parameters.size(); ++i)
+        sqlite3_bind_text(stmt, static_cast<int>(i + 1), parameters[i].c_str(), -1, SQLITE_TRANSIENT);
+
+    std::size_t rows = 0;
+    while (SQLITE_ROW == sqlite3_step(stmt)) {
+        const int level = sqlite3_column_int(stmt, 2);
+        std::cout << columnText(stmt, 0) << "\t" << columnText(stmt, 1) << "\t"
+                  << (level >= 0 && level < __levelCount ? __levelNames[level] : "UNKNOWN") << "\t"
+                  << columnText(stmt, 3) << "\t" << columnText(stmt, 4) << "\t" << columnText(stmt, 5) << "\t"
+                  << columnText(stmt, 6) << "\n";
+        rows += 1;
+    }
+
+    sqlite3_finalize(stmt);
+    sqlite3_close_v2(database);
+
+    std::cerr << rows << " messages\n";
+    return EXIT_SUCCESS;
+}
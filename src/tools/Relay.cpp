@@ -0,0 +1,752 @@
+/*
+ * @brief Caching relay between the plugins of several controllers and the vACDM backend
+ * @details The relay serves the REST endpoints of the backend which are used by the plugin. The pilots of all airports
+ * requested by the clients are polled once per interval with the com::Server of the plugin, every client is served
+ * from the same snapshot. Writes are journaled in an outbox and forwarded to the backend in order.
+ * Point SERVER_url of the plugins to the relay, e.g. SERVER_url=http://192.168.0.10:8080
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/Server.h"
+#include "log/Logger.h"
+#include "types/PilotJson.h"
+
+using namespace vacdm;
+using namespace std::chrono_literals;
+
+namespace {
+// airports which were not requested by any client within this time are not polled anymore
+constexpr auto __airportIdleTimeout = 60s;
+// a client with an airport which is not part of the snapshot waits for the next poll at most this time
+constexpr auto __refreshTimeout = 5s;
+// the version and the configuration of the backend change rarely
+constexpr auto __documentMaximumAge = 60s;
+constexpr auto __connectionTimeout = 60s;
+// the pending writes are retried at this interval while the backend is unreachable
+constexpr auto __writeRetryInterval = 5s;
+constexpr auto __statisticsInterval = 60s;
+constexpr std::size_t __maximumHeaderSize = 64 * 1024;
+constexpr std::size_t __maximumBodySize = 1024 * 1024;
+
+struct RelayOptions {
+    std::string upstream = "https://app.vacdm.net";
+    std::vector<std::string> mirrors;
+    std::string address = "0.0.0.0";
+    int port = 8080;
+    std::chrono::seconds interval = 2s;
+    std::string outbox = "vacdm_relay_outbox.bin";
+    bool logging = false;
+};
+
+struct Request {
+    std::string method;
+    std::string path;
+    std::string query;
+    std::map<std::string, std::string> headers;
+    std::string body;
+    bool keepAlive = true;
+};
+
+struct Response {
+    int status = 200;
+    std::string body;
+    std::vector<std::pair<std::string, std::string>> headers;
+};
+
+/// @brief a serialized response of the snapshot, the entity tag is derived from the body
+struct Document {
+    std::string body;
+    std::string etag;
+};
+
+void printUsage(const char *executable) {
+    std::cerr << "Usage: " << executable << " [options]\n"
+              << "  --upstream URL        base URL of the backend, default https://app.vacdm.net\n"
+              << "  --mirror URL          base URL of a backend mirror, may be repeated\n"
+              << "  --bind ADDRESS        local address to listen on, default 0.0.0.0\n"
+              << "  --port PORT           local port to listen on, default 8080\n"
+              << "  --interval SECONDS    interval of the upstream pilot polls, default 2\n"
+              << "  --outbox FILE         journal of the writes which are not forwarded yet\n"
+              << "  --log                 writes the messages of the backend communication to a .vacdm log\n";
+}
+
+bool parseArguments(int argc, char **argv, RelayOptions &options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if ("--log" == argument) {
+            options.logging = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+
+        const std::string value = argv[++i];
+        if ("--upstream" == argument) {
+            options.upstream = value;
+            while (false == options.upstream.empty() && '/' == options.upstream.back()) options.upstream.pop_back();
+        } else if ("--mirror" == argument) {
+            options.mirrors.push_back(value);
+            auto &mirror = options.mirrors.back();
+            while (false == mirror.empty() && '/' == mirror.back()) mirror.pop_back();
+        } else if ("--bind" == argument) {
+            options.address = value;
+        } else if ("--port" == argument) {
+            options.port = std::atoi(value.c_str());
+            if (options.port <= 0 || options.port > 65535) return false;
+        } else if ("--interval" == argument) {
+            options.interval = std::chrono::seconds(std::max(1, std::atoi(value.c_str())));
+        } else if ("--outbox" == argument) {
+            options.outbox = value;
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string lowercase(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+std::string decodeUrl(const std::string &value) {
+    std::string decoded;
+    decoded.reserve(value.size());
+
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        if ('+' == value[i]) {
+            decoded.push_back(' ');
+        } else if ('%' == value[i] && i + 2 < value.size() && std::isxdigit(static_cast<unsigned char>(value[i + 1])) &&
+                   std::isxdigit(static_cast<unsigned char>(value[i + 2]))) {
+            decoded.push_back(static_cast<char>(std::stoi(value.substr(i + 1, 2), nullptr, 16)));
+            i += 2;
+        } else {
+            decoded.push_back(value[i]);
+        }
+    }
+
+    return decoded;
+}
+
+/// @brief FNV-1a hash of the body, used as a strong entity tag
+std::string entityTag(const std::string &body) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const auto c : body) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+
+    char buffer[20];
+    std::snprintf(buffer, sizeof(buffer), "\"%016llx\"", static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+const char *reasonPhrase(int status) {
+    switch (status) {
+        case 200:
+            return "OK";
+        case 202:
+            return "Accepted";
+        case 304:
+            return "Not Modified";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        case 405:
+            return "Method Not Allowed";
+        case 413:
+            return "Payload Too Large";
+        case 502:
+            return "Bad Gateway";
+        case 503:
+            return "Service Unavailable";
+        default:
+            return "Unknown";
+    }
+}
+
+/// @brief the pilots of the requested airports, polled once per interval for all clients
+class PilotCache {
+   private:
+    std::mutex m_lock;
+    std::condition_variable m_polled;
+    std::chrono::seconds m_interval;
+    /// @brief the last request of every airport, an empty name stands for the unfiltered pilot list
+    std::map<std::string, std::chrono::steady_clock::time_point> m_airports;
+    std::shared_ptr<const Json::Value> m_pilots;
+    std::set<std::string> m_polledAirports;
+    std::chrono::steady_clock::time_point m_lastPoll;
+    std::chrono::steady_clock::time_point m_received;
+    std::uint64_t m_generation;
+    std::uint64_t m_attempts;
+    bool m_refreshRequested;
+    /// @brief the serialized responses of the current generation, keyed by the airports and fields of the query
+    std::unordered_map<std::string, std::shared_ptr<const Document>> m_documents;
+    std::atomic<std::uint64_t> m_servedResponses;
+    std::atomic<std::uint64_t> m_notModifiedResponses;
+    std::atomic<std::uint64_t> m_polls;
+    std::thread m_poller;
+
+    bool covers(const std::set<std::string> &airports) const {
+        if (nullptr == this->m_pilots) return false;
+        if (0 != this->m_polledAirports.count("")) return true;
+
+        return std::all_of(airports.cbegin(), airports.cend(),
+                           [this](const std::string &airport) { return 0 != this->m_polledAirports.count(airport); });
+    }
+
+    static std::shared_ptr<const Document> serialize(const Json::Value &pilots, const std::set<std::string> &airports,
+                                                     const std::vector<std::string> &fields) {
+        Json::Value root(Json::arrayValue);
+        for (const auto &pilot : pilots) {
+            const auto &flightplan = types::jsonMember(pilot, "flightplan");
+            if (0 == airports.count("") && 0 == airports.count(types::jsonMember(flightplan, "departure").asString()))
+                continue;
+
+            if (true == fields.empty()) {
+                root.append(pilot);
+                continue;
+            }
+
+            // same projection as the backend, only the requested top-level fields are returned
+            Json::Value projection(Json::objectValue);
+            for (const auto &field : fields) {
+                const auto &member = types::jsonMember(pilot, field.c_str());
+                if (false == member.isNull()) projection[field] = member;
+            }
+            root.append(std::move(projection));
+        }
+
+        Json::StreamWriterBuilder builder{};
+        builder["indentation"] = "";
+        auto document = std::make_shared<Document>();
+        document->body = Json::writeString(builder, root);
+        document->etag = entityTag(document->body);
+        return document;
+    }
+
+    void poll() {
+        while (true) {
+            std::list<std::string> airports;
+            {
+                std::unique_lock guard(this->m_lock);
+                this->m_polled.wait_for(guard, this->m_interval - (std::chrono::steady_clock::now() - this->m_lastPoll),
+                                        [this] { return true == this->m_refreshRequested; });
+
+                const auto now = std::chrono::steady_clock::now();
+                this->m_refreshRequested = false;
+                this->m_lastPoll = now;
+                std::erase_if(this->m_airports, [now](const auto &airport) {
+                    return now - airport.second > __airportIdleTimeout;
+                });
+
+                // the unfiltered list contains the pilots of all airports
+                if (0 == this->m_airports.count("")) {
+                    for (const auto &airport : std::as_const(this->m_airports)) airports.push_back(airport.first);
+                }
+                if (true == this->m_airports.empty()) continue;
+            }
+
+            if (false == com::Server::instance().checkWebApi()) {
+                std::cerr << "Backend unavailable: " << com::Server::instance().errorMessage() << "\n";
+                std::lock_guard guard(this->m_lock);
+                this->m_attempts += 1;
+                this->m_polled.notify_all();
+                continue;
+            }
+
+            auto pilots = std::make_shared<Json::Value>();
+            const auto answered = com::Server::instance().getPilotsJson(airports, *pilots);
+            this->m_polls += 1;
+
+            std::lock_guard guard(this->m_lock);
+            this->m_attempts += 1;
+            // incomplete responses are dropped, the clients are served from the last complete snapshot
+            if (true == answered) {
+                this->m_pilots = std::move(pilots);
+                this->m_polledAirports = airports.empty() ? std::set<std::string>{""}
+                                                          : std::set<std::string>(airports.cbegin(), airports.cend());
+                this->m_received = std::chrono::steady_clock::now();
+                this->m_generation += 1;
+                this->m_documents.clear();
+            }
+            this->m_polled.notify_all();
+        }
+    }
+
+   public:
+    explicit PilotCache(std::chrono::seconds interval)
+        : m_interval(interval),
+          m_lastPoll(),
+          m_received(),
+          m_generation(0),
+          m_attempts(0),
+          m_refreshRequested(false),
+          m_servedResponses(0),
+          m_notModifiedResponses(0),
+          m_polls(0) {
+        this->m_poller = std::thread(&PilotCache::poll, this);
+        this->m_poller.detach();
+    }
+
+    /// @brief returns the pilots of the airports, an empty set requests all pilots
+    /// @param fields the requested top-level fields, all fields if it is empty
+    /// @param age receives the age of the snapshot
+    /// @return nullptr if the backend has not answered yet
+    std::shared_ptr<const Document> pilots(std::set<std::string> airports, const std::vector<std::string> &fields,
+                                           std::chrono::seconds &age) {
+        if (true == airports.empty()) airports.insert("");
+
+        std::unique_lock guard(this->m_lock);
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto &airport : std::as_const(airports)) this->m_airports[airport] = now;
+
+        // new airports are polled immediately, the other clients keep being served from the snapshot meanwhile
+        if (false == this->covers(airports)) {
+            this->m_refreshRequested = true;
+            this->m_polled.notify_all();
+
+            const auto attempts = this->m_attempts;
+            this->m_polled.wait_for(guard, __refreshTimeout, [this, attempts, &airports] {
+                return true == this->covers(airports) || attempts + 1 < this->m_attempts;
+            });
+        }
+        if (nullptr == this->m_pilots) return nullptr;
+
+        age = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - this->m_received);
+
+        std::string key;
+        for (const auto &airport : std::as_const(airports)) key += airport + ",";
+        key += "|";
+        for (const auto &field : fields) key += field + ",";
+
+        const auto cached = this->m_documents.find(key);
+        if (this->m_documents.cend() != cached) return cached->second;
+
+        // serialize outside of the lock, the snapshot is immutable
+        const auto snapshot = this->m_pilots;
+        const auto generation = this->m_generation;
+        guard.unlock();
+        auto document = PilotCache::serialize(*snapshot, airports, fields);
+        guard.lock();
+
+        if (generation == this->m_generation) this->m_documents.emplace(key, document);
+        return document;
+    }
+
+    /// @brief polls the backend as soon as possible, e.g. after a forwarded write
+    void invalidate() {
+        std::lock_guard guard(this->m_lock);
+        this->m_refreshRequested = true;
+        this->m_polled.notify_all();
+    }
+
+    std::chrono::seconds interval() const { return this->m_interval; }
+
+    void recordResponse(bool notModified) {
+        this->m_servedResponses += 1;
+        if (true == notModified) this->m_notModifiedResponses += 1;
+    }
+
+    std::string status() {
+        std::size_t airports = 0;
+        {
+            std::lock_guard guard(this->m_lock);
+            airports = this->m_airports.size();
+        }
+
+        return "Served " + std::to_string(this->m_servedResponses) + " pilot responses (" +
+               std::to_string(this->m_notModifiedResponses) + " not modified) from " +
+               std::to_string(this->m_polls) + " upstream polls, " + std::to_string(airports) + " active airports";
+    }
+};
+
+/// @brief sends the journaled writes of the clients on an own thread, the connections do not wait for the backend
+class WriteForwarder {
+   private:
+    std::mutex m_lock;
+    std::condition_variable m_queued;
+    bool m_pending;
+    PilotCache &m_pilots;
+    std::thread m_writer;
+
+    void run() {
+        while (true) {
+            {
+                std::unique_lock guard(this->m_lock);
+                this->m_queued.wait_for(guard, __writeRetryInterval, [this] { return true == this->m_pending; });
+                this->m_pending = false;
+            }
+
+            auto &server = com::Server::instance();
+            const auto pending = server.pendingWrites();
+            if (0 == pending) continue;
+
+            // the delivered writes change the pilots, the snapshot is refreshed instead of waiting for the next poll
+            server.flushOutbox();
+            if (server.pendingWrites() < pending) this->m_pilots.invalidate();
+        }
+    }
+
+   public:
+    explicit WriteForwarder(PilotCache &pilots) : m_pending(false), m_pilots(pilots) {
+        this->m_writer = std::thread(&WriteForwarder::run, this);
+        this->m_writer.detach();
+    }
+
+    /// @brief wakes the writer thread after a write was journaled
+    void notify() {
+        std::lock_guard guard(this->m_lock);
+        this->m_pending = true;
+        this->m_queued.notify_all();
+    }
+};
+
+/// @brief the rarely changing documents of the backend, e.g. the version and the configuration
+class DocumentCache {
+   private:
+    struct Entry {
+        int status;
+        std::string body;
+        std::chrono::steady_clock::time_point received;
+    };
+
+    std::mutex m_lock;
+    std::map<std::string, Entry> m_entries;
+
+   public:
+    bool get(const std::string &endpoint, Response &response) {
+        const auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard guard(this->m_lock);
+            const auto entry = this->m_entries.find(endpoint);
+            if (this->m_entries.cend() != entry && now - entry->second.received < __documentMaximumAge) {
+                response.status = entry->second.status;
+                response.body = entry->second.body;
+                return true;
+            }
+        }
+
+        std::string body;
+        long status = 0;
+        if (false == com::Server::instance().getDocument(endpoint, body, status)) return false;
+
+        std::lock_guard guard(this->m_lock);
+        this->m_entries[endpoint] = {static_cast<int>(status), body, now};
+        response.status = static_cast<int>(status);
+        response.body = std::move(body);
+        return true;
+    }
+};
+
+class Relay {
+   private:
+    PilotCache m_pilots;
+    WriteForwarder m_writes;
+    DocumentCache m_documents;
+
+    Response getPilots(const Request &request) {
+        std::set<std::string> airports;
+        std::vector<std::string> fields;
+
+        std::istringstream query(request.query);
+        std::string parameter;
+        while (std::getline(query, parameter, '&')) {
+            const auto separator = parameter.find('=');
+            if (std::string::npos == separator) continue;
+
+            const auto key = parameter.substr(0, separator);
+            const auto value = decodeUrl(parameter.substr(separator + 1));
+            if ("adep" == key) {
+                airports.insert(value);
+            } else if ("fields" == key) {
+                std::istringstream list(value);
+                std::string field;
+                while (std::getline(list, field, ','))
+                    if (false == field.empty()) fields.push_back(field);
+            }
+        }
+
+        Response response;
+        std::chrono::seconds age{0};
+        const auto document = this->m_pilots.pilots(airports, fields, age);
+        if (nullptr == document) {
+            response.status = 502;
+            return response;
+        }
+
+        // the clients may reuse the response until the next poll
+        const auto maximumAge = std::max(this->m_pilots.interval() - age, std::chrono::seconds(0));
+        response.headers.emplace_back("Cache-Control", "max-age=" + std::to_string(maximumAge.count()));
+        response.headers.emplace_back("Age", std::to_string(age.count()));
+        response.headers.emplace_back("ETag", document->etag);
+        response.headers.emplace_back("Content-Type", "application/json");
+
+        const auto ifNoneMatch = request.headers.find("if-none-match");
+        const auto notModified = request.headers.cend() != ifNoneMatch && document->etag == ifNoneMatch->second;
+        this->m_pilots.recordResponse(notModified);
+        if (true == notModified) {
+            response.status = 304;
+        } else {
+            response.body = document->body;
+        }
+
+        return response;
+    }
+
+    Response forwardWrite(const Request &request) {
+        Response response;
+
+        com::Outbox::Method method;
+        std::string callsign;
+        if ("POST" == request.method && "/api/v1/pilots" == request.path) {
+            method = com::Outbox::Method::Post;
+
+            Json::CharReaderBuilder builder{};
+            auto reader = std::unique_ptr<Json::CharReader>(builder.newCharReader());
+            std::string errors;
+            Json::Value root;
+            const auto &body = request.body;
+            if (false == reader->parse(body.data(), body.data() + body.size(), &root, &errors)) {
+                response.status = 400;
+                return response;
+            }
+            callsign = types::jsonMember(root, "callsign").asString();
+        } else if (("PATCH" == request.method || "DELETE" == request.method) &&
+                   0 == request.path.rfind("/api/v1/pilots/", 0)) {
+            method = "PATCH" == request.method ? com::Outbox::Method::Patch : com::Outbox::Method::Delete;
+            callsign = request.path.substr(std::string("/api/v1/pilots/").size());
+        } else {
+            response.status = 405;
+            return response;
+        }
+
+        // the write is journaled before it is acknowledged, the writer thread delivers it once the backend is reachable
+        if (false == com::Server::instance().forwardWrite(method, callsign, request.path, request.body)) {
+            response.status = 503;
+            return response;
+        }
+
+        this->m_writes.notify();
+        response.status = 202;
+        return response;
+    }
+
+   public:
+    explicit Relay(const RelayOptions &options) : m_pilots(options.interval), m_writes(this->m_pilots), m_documents() {}
+
+    Response handle(const Request &request) {
+        if ("GET" == request.method) {
+            if ("/api/v1/pilots" == request.path) return this->getPilots(request);
+
+            Response response;
+            if ("/api/v1/version" == request.path || "/api/v1/config" == request.path) {
+                if (false == this->m_documents.get(request.path, response)) response.status = 502;
+                response.headers.emplace_back("Content-Type", "application/json");
+                return response;
+            }
+
+            // the push channel is not relayed, the plugins fall back to the polls
+            response.status = 404;
+            return response;
+        }
+
+        return this->forwardWrite(request);
+    }
+
+    std::string status() { return this->m_pilots.status(); }
+};
+
+bool sendAll(int socket, const std::string &data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        const auto result = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (result <= 0) return false;
+        sent += static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+/// @brief reads the next request of the connection, the buffer keeps the bytes of pipelined requests
+/// @return false if the connection is closed or the request is invalid
+bool readRequest(int socket, std::string &buffer, Request &request, int &errorStatus) {
+    char chunk[16 * 1024];
+
+    std::size_t headerEnd = std::string::npos;
+    while (std::string::npos == (headerEnd = buffer.find("\r\n\r\n"))) {
+        if (buffer.size() > __maximumHeaderSize) {
+            errorStatus = 413;
+            return false;
+        }
+
+        const auto received = ::recv(socket, chunk, sizeof(chunk), 0);
+        if (received <= 0) return false;
+        buffer.append(chunk, static_cast<std::size_t>(received));
+    }
+
+    std::istringstream header(buffer.substr(0, headerEnd));
+    std::string line, target, version;
+    std::getline(header, line);
+    std::istringstream requestLine(line);
+    if (!(requestLine >> request.method >> target >> version)) {
+        errorStatus = 400;
+        return false;
+    }
+
+    const auto querySeparator = target.find('?');
+    request.path = target.substr(0, querySeparator);
+    request.query = std::string::npos != querySeparator ? target.substr(querySeparator + 1) : "";
+
+    request.headers.clear();
+    while (std::getline(header, line)) {
+        if (false == line.empty() && '\r' == line.back()) line.pop_back();
+        const auto separator = line.find(':');
+        if (std::string::npos == separator) continue;
+
+        auto value = line.substr(separator + 1);
+        value.erase(0, value.find_first_not_of(' '));
+        request.headers[lowercase(line.substr(0, separator))] = value;
+    }
+
+    const auto connection = request.headers.find("connection");
+    request.keepAlive = request.headers.cend() != connection ? "close" != lowercase(connection->second)
+                                                             : "HTTP/1.1" == version;
+
+    std::size_t contentLength = 0;
+    const auto length = request.headers.find("content-length");
+    if (request.headers.cend() != length) contentLength = std::strtoull(length->second.c_str(), nullptr, 10);
+    if (contentLength > __maximumBodySize) {
+        errorStatus = 413;
+        return false;
+    }
+
+    const auto bodyStart = headerEnd + 4;
+    while (buffer.size() < bodyStart + contentLength) {
+        const auto received = ::recv(socket, chunk, sizeof(chunk), 0);
+        if (received <= 0) return false;
+        buffer.append(chunk, static_cast<std::size_t>(received));
+    }
+
+    request.body = buffer.substr(bodyStart, contentLength);
+    buffer.erase(0, bodyStart + contentLength);
+    return true;
+}
+
+bool writeResponse(int socket, const Response &response, bool keepAlive) {
+    std::string message = "HTTP/1.1 " + std::to_string(response.status) + " " + reasonPhrase(response.status) + "\r\n";
+    for (const auto &[name, value] : response.headers) message += name + ": " + value + "\r\n";
+    message += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+    message += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    message += response.body;
+
+    return sendAll(socket, message);
+}
+
+void serveConnection(Relay &relay, int socket) {
+    // idle connections are closed, the clients reconnect with their next request
+    timeval timeout{static_cast<time_t>(__connectionTimeout.count()), 0};
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::string buffer;
+    while (true) {
+        Request request;
+        int errorStatus = 0;
+        if (false == readRequest(socket, buffer, request, errorStatus)) {
+            if (0 != errorStatus) {
+                Response response;
+                response.status = errorStatus;
+                writeResponse(socket, response, false);
+            }
+            break;
+        }
+
+        const auto response = relay.handle(request);
+        if (false == writeResponse(socket, response, request.keepAlive) || false == request.keepAlive) break;
+    }
+
+    ::close(socket);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    RelayOptions options;
+    if (false == parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // same commands as in EuroScope, the messages of the other senders are not written by the relay
+    if (true == options.logging) {
+        logging::Logger::instance().handleLogLevelCommand(".vacdm LOGLEVEL SERVER INFO");
+        logging::Logger::instance().handleLogCommand(".vacdm LOG ON");
+    }
+
+    auto &server = com::Server::instance();
+    server.changeServerAddress(options.upstream, options.mirrors);
+    // the clients only write while they are master, the relay forwards their writes
+    server.setMaster(true);
+    server.openOutbox(options.outbox);
+
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    const int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(options.port));
+    if (1 != inet_pton(AF_INET, options.address.c_str(), &address.sin_addr) ||
+        0 != ::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) || 0 != ::listen(listener, 64)) {
+        std::cerr << "Unable to listen on " << options.address << ":" << options.port << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Relaying " << options.upstream << " on " << options.address << ":" << options.port << " every "
+              << options.interval.count() << " s" << std::endl;
+
+    Relay relay(options);
+    std::thread statistics([&relay, &server] {
+        while (true) {
+            std::this_thread::sleep_for(__statisticsInterval);
+
+            std::cout << relay.status() << ", " << server.pendingWrites() << " pending writes\n";
+            for (const auto &status : server.mirrorStatus()) std::cout << "  " << status << "\n";
+            for (const auto &status : server.transferStatus()) std::cout << "  " << status << "\n";
+            std::cout.flush();
+        }
+    });
+    statistics.detach();
+
+    while (true) {
+        const int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0) continue;
+
+        std::thread(serveConnection, std::ref(relay), client).detach();
+    }
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Pilot.h"
+
+namespace vacdm::types {
+/// @brief zero-terminated string with inline storage, longer values are truncated
+/// @details The unused bytes are always zero, two strings are equal if their storage is equal.
+template <std::size_t N>
+struct FixedString {
+    static_assert(N > 1, "FixedString needs space for at least one character");
+
+    char data[N] = {};
+
+    void assign(std::string_view value) {
+        const auto length = std::min(value.size(), N - 1);
+        std::memcpy(this->data, value.data(), length);
+        std::memset(this->data + length, 0, N - length);
+    }
+
+    std::string_view view() const { return std::string_view(this->data); }
+    std::string str() const { return std::string(this->view()); }
+    bool empty() const { return '\0' == this->data[0]; }
+
+    bool operator==(const FixedString &other) const { return 0 == std::memcmp(this->data, other.data, N); }
+    bool operator!=(const FixedString &other) const { return false == (*this == other); }
+};
+
+/// @brief timestamp with a resolution of one second, stored as 32-bit offset to the session epoch
+/// @details types::defaultTime is stored as sentinel and restored on conversion.
+class CompactTime {
+   public:
+    static constexpr std::int32_t Unset = std::numeric_limits<std::int32_t>::min();
+
+   private:
+    std::int32_t m_offset = Unset;
+
+   public:
+    CompactTime() = default;
+    CompactTime(const std::chrono::utc_clock::time_point &value) { *this = value; }
+
+    /// @brief the reference point of all offsets, fixed at the first use in the session
+    static const std::chrono::utc_clock::time_point &epoch() {
+        static const std::chrono::utc_clock::time_point __epoch =
+            std::chrono::floor<std::chrono::hours>(std::chrono::utc_clock::now());
+        return __epoch;
+    }
+
+    CompactTime &operator=(const std::chrono::utc_clock::time_point &value) {
+        if (defaultTime == value) {
+            this->m_offset = Unset;
+        } else {
+            // saturate instead of wrapping around, the range covers roughly +/- 68 years
+            const auto offset = std::chrono::floor<std::chrono::seconds>(value - CompactTime::epoch()).count();
+            this->m_offset = static_cast<std::int32_t>(
+                std::clamp<std::int64_t>(offset, static_cast<std::int64_t>(Unset) + 1,
+                                         std::numeric_limits<std::int32_t>::max()));
+        }
+        return *this;
+    }
+
+    std::chrono::utc_clock::time_point get() const {
+        if (Unset == this->m_offset) return defaultTime;
+        return CompactTime::epoch() + std::chrono::seconds(this->m_offset);
+    }
+
+    bool operator==(const CompactTime &other) const { return this->m_offset == other.m_offset; }
+    bool operator!=(const CompactTime &other) const { return this->m_offset != other.m_offset; }
+};
+
+/// @brief duration in minutes that is transported as time point since the UNIX epoch, e.g. the EXOT
+class CompactMinutes {
+   public:
+    static constexpr std::int16_t Unset = std::numeric_limits<std::int16_t>::min();
+
+   private:
+    std::int16_t m_minutes = Unset;
+
+   public:
+    CompactMinutes() = default;
+    CompactMinutes(const std::chrono::utc_clock::time_point &value) { *this = value; }
+
+    CompactMinutes &operator=(const std::chrono::utc_clock::time_point &value) {
+        if (defaultTime == value) {
+            this->m_minutes = Unset;
+        } else {
+            const auto minutes = std::chrono::floor<std::chrono::minutes>(value.time_since_epoch()).count();
+            this->m_minutes = static_cast<std::int16_t>(std::clamp<std::int64_t>(
+                minutes, static_cast<std::int64_t>(Unset) + 1, std::numeric_limits<std::int16_t>::max()));
+        }
+        return *this;
+    }
+
+    std::chrono::utc_clock::time_point get() const {
+        if (Unset == this->m_minutes) return defaultTime;
+        return std::chrono::utc_clock::time_point(std::chrono::minutes(this->m_minutes));
+    }
+};
+
+/// @brief position and flightplan data of one source, EuroScope and the backend are compared to find the changes
+struct FlightplanData {
+    double latitude = 0.0;
+    double longitude = 0.0;
+    FixedString<8> origin;
+    FixedString<8> destination;
+    FixedString<8> runway;
+    FixedString<16> sid;
+    bool inactive = false;
+
+    /// @brief copies the EuroScope fields of the pilot
+    void assign(const Pilot &pilot);
+};
+
+/// @brief A-CDM procedure data, defined by the backend and changed locally by the tag functions
+struct AcdmData {
+    CompactTime lastUpdate;
+    CompactTime eobt;
+    CompactTime tobt;
+    CompactTime ctot;
+    CompactTime ttot;
+    CompactTime tsat;
+    CompactTime asat;
+    CompactTime aobt;
+    CompactTime atot;
+    CompactTime asrt;
+    CompactTime aort;
+    CompactMinutes exot;
+    FixedString<12> tobtState;
+    bool hasBooking = false;
+    bool taxizoneIsTaxiout = false;
+};
+
+/// @brief JSON representation of a field
+enum class FieldType : std::uint8_t { String, Number, Boolean, Timestamp, Minutes };
+/// @brief the source of truth of a field, EuroScope fields are stored in FlightplanData, backend fields in AcdmData
+enum class FieldSource : std::uint8_t { EuroScope, Backend };
+
+/// @brief describes one field of types::Pilot
+template <typename Value, typename Storage>
+struct PilotField {
+    Value Pilot::*member;
+    /// @brief the member of FlightplanData or AcdmData which stores the field in the record, nullptr if not stored
+    Storage storage;
+    FieldType type;
+    FieldSource source;
+    /// @brief the JSON object containing the field, nullptr for fields of the root object
+    const char *group;
+    const char *key;
+    /// @brief EuroScope changes of the field are patched to the backend
+    bool patchable;
+    /// @brief the field is sent when a pilot is posted to the backend
+    bool posted;
+};
+
+/// @brief the fields of types::Pilot, the ECFMP measures are handled separately
+inline constexpr auto pilotFields = [] {
+    using enum FieldType;
+    using enum FieldSource;
+
+    // member, storage, type, source, group, key, patchable, posted
+    return std::make_tuple(
+        PilotField{&Pilot::callsign, nullptr, String, EuroScope, nullptr, "callsign", false, true},
+        PilotField{&Pilot::lastUpdate, &AcdmData::lastUpdate, Timestamp, Backend, nullptr, "updatedAt", false, false},
+        PilotField{&Pilot::inactive, &FlightplanData::inactive, Boolean, EuroScope, nullptr, "inactive", true, false},
+        PilotField{&Pilot::latitude, &FlightplanData::latitude, Number, EuroScope, "position", "lat", true, true},
+        PilotField{&Pilot::longitude, &FlightplanData::longitude, Number, EuroScope, "position", "lon", true, true},
+        PilotField{&Pilot::taxizoneIsTaxiout, &AcdmData::taxizoneIsTaxiout, Boolean, Backend,
+                   "vacdm", "taxizoneIsTaxiout", false, false},
+        PilotField{&Pilot::origin, &FlightplanData::origin, String, EuroScope, "flightplan", "departure", true, true},
+        PilotField{&Pilot::destination, &FlightplanData::destination, String, EuroScope,
+                   "flightplan", "arrival", true, true},
+        PilotField{&Pilot::runway, &FlightplanData::runway, String, EuroScope, "clearance", "dep_rwy", true, true},
+        PilotField{&Pilot::sid, &FlightplanData::sid, String, EuroScope, "clearance", "sid", true, true},
+        PilotField{&Pilot::eobt, &AcdmData::eobt, Timestamp, Backend, "vacdm", "eobt", false, true},
+        PilotField{&Pilot::tobt, &AcdmData::tobt, Timestamp, Backend, "vacdm", "tobt", false, true},
+        PilotField{&Pilot::tobt_state, &AcdmData::tobtState, String, Backend, "vacdm", "tobt_state", false, false},
+        PilotField{&Pilot::ctot, &AcdmData::ctot, Timestamp, Backend, "vacdm", "ctot", false, false},
+        PilotField{&Pilot::ttot, &AcdmData::ttot, Timestamp, Backend, "vacdm", "ttot", false, false},
+        PilotField{&Pilot::tsat, &AcdmData::tsat, Timestamp, Backend, "vacdm", "tsat", false, false},
+        PilotField{&Pilot::exot, &AcdmData::exot, Minutes, Backend, "vacdm", "exot", false, false},
+        PilotField{&Pilot::asat, &AcdmData::asat, Timestamp, Backend, "vacdm", "asat", false, false},
+        PilotField{&Pilot::aobt, &AcdmData::aobt, Timestamp, Backend, "vacdm", "aobt", false, false},
+        PilotField{&Pilot::atot, &AcdmData::atot, Timestamp, Backend, "vacdm", "atot", false, false},
+        PilotField{&Pilot::asrt, &AcdmData::asrt, Timestamp, Backend, "vacdm", "asrt", false, false},
+        PilotField{&Pilot::aort, &AcdmData::aort, Timestamp, Backend, "vacdm", "aort", false, false},
+        PilotField{&Pilot::hasBooking, &AcdmData::hasBooking, Boolean, Backend, nullptr, "hasBooking", false, false});
+}();
+
+/// @brief calls the function with std::integral_constant<std::size_t, I> for every field index I
+/// @details The loop is unrolled at compile time, use pilotField<decltype(index)::value>() to access the descriptor.
+template <typename Function>
+constexpr void forEachPilotField(Function &&function) {
+    [&function]<std::size_t... Index>(std::index_sequence<Index...>) {
+        (function(std::integral_constant<std::size_t, Index>()), ...);
+    }(std::make_index_sequence<std::tuple_size_v<decltype(pilotFields)>>());
+}
+
+template <std::size_t Index>
+constexpr const auto &pilotField() {
+    return std::get<Index>(pilotFields);
+}
+
+/// @brief checks if the field is stored in the overlay of a source
+template <std::size_t Index>
+constexpr bool isStored() {
+    return false == std::is_null_pointer_v<decltype(pilotField<Index>().storage)>;
+}
+
+template <typename Member>
+struct MemberOwner {
+    using type = void;
+};
+template <typename Owner, typename Value>
+struct MemberOwner<Value Owner::*> {
+    using type = Owner;
+};
+
+// the stored fields need to be part of the overlay of their source
+static_assert([]<std::size_t... Index>(std::index_sequence<Index...>) {
+    return (... && (false == isStored<Index>() ||
+                    std::is_same_v<typename MemberOwner<decltype(pilotField<Index>().storage)>::type,
+                                   std::conditional_t<FieldSource::EuroScope == pilotField<Index>().source,
+                                                      FlightplanData, AcdmData>>));
+}(std::make_index_sequence<std::tuple_size_v<decltype(pilotFields)>>()));
+
+/// @brief stores a value of types::Pilot in the compact storage of the record
+template <typename Storage, typename Value>
+void storeField(Storage &storage, const Value &value) {
+    if constexpr (requires { storage.view(); })
+        storage.assign(value);
+    else
+        storage = value;
+}
+
+/// @brief returns the value of the compact storage as it is stored in types::Pilot
+template <typename Storage>
+auto loadField(const Storage &storage) {
+    if constexpr (requires { storage.view(); })
+        return storage.str();
+    else if constexpr (requires { storage.get(); })
+        return storage.get();
+    else
+        return storage;
+}
+
+/// @brief stores the value of the compact storage in the field of types::Pilot, strings reuse their capacity
+template <typename Storage, typename Value>
+void loadField(const Storage &storage, Value &value) {
+    if constexpr (requires { storage.view(); })
+        value.assign(storage.view());
+    else
+        value = loadField(storage);
+}
+
+inline void FlightplanData::assign(const Pilot &pilot) {
+    forEachPilotField([this, &pilot](auto index) {
+        constexpr const auto &field = pilotField<decltype(index)::value>();
+        if constexpr (FieldSource::EuroScope == field.source && true == isStored<decltype(index)::value>())
+            storeField(this->*field.storage, pilot.*field.member);
+    });
+}
+}  // namespace vacdm::types
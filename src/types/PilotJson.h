@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include <json/json.h>
+
+#include "types/Pilot.h"
+#include "types/PilotFields.h"
+#include "utils/Date.h"
+
+namespace vacdm::types {
+/// @brief returns the member of a JSON object without creating it, a null value if it does not exist
+inline const Json::Value &jsonMember(const Json::Value &object, const char *key) {
+    if (false == object.isObject()) return Json::Value::nullSingleton();
+    const auto member = object.find(key, key + std::strlen(key));
+    return nullptr != member ? *member : Json::Value::nullSingleton();
+}
+
+template <FieldType Type, typename Value>
+void fromJson(const Json::Value &json, Value &value) {
+    if constexpr (FieldType::String == Type)
+        value = json.asString();
+    else if constexpr (FieldType::Number == Type)
+        value = json.asDouble();
+    else if constexpr (FieldType::Boolean == Type)
+        value = json.asBool();
+    else if constexpr (FieldType::Timestamp == Type)
+        value = utils::Date::isoStringToTimestamp(json.asString());
+    else
+        value = std::chrono::utc_clock::time_point(std::chrono::minutes(json.asInt64()));
+}
+
+template <FieldType Type, typename Value>
+Json::Value toJson(const Value &value) {
+    if constexpr (FieldType::Timestamp == Type)
+        return utils::Date::timestampToIsoString(value);
+    else if constexpr (FieldType::Minutes == Type)
+        return std::chrono::duration_cast<std::chrono::minutes>(value.time_since_epoch()).count();
+    else
+        return value;
+}
+
+/// @brief returns the JSON value of a field, the group object is created if needed
+template <typename Field>
+Json::Value &jsonTarget(Json::Value &root, const Field &field) {
+    return nullptr != field.group ? root[field.group][field.key] : root[field.key];
+}
+
+/// @brief parses the fields of a pilot received from the backend, the ECFMP measures are parsed by parseMeasures
+inline void parsePilot(const Json::Value &json, Pilot &pilot) {
+    forEachPilotField([&json, &pilot](auto index) {
+        constexpr const auto &field = pilotField<decltype(index)::value>();
+        const auto &object = nullptr != field.group ? jsonMember(json, field.group) : json;
+        fromJson<field.type>(jsonMember(object, field.key), pilot.*field.member);
+    });
+}
+
+/// @brief parses the ECFMP measures of a pilot received from the backend
+inline void parseMeasures(const Json::Value &json, Pilot &pilot) {
+    const auto &measures = jsonMember(json, "measures");
+    if (false == measures.isArray()) return;
+
+    pilot.measures.clear();
+    pilot.measures.reserve(measures.size());
+    for (const auto &measure : measures) {
+        pilot.measures.push_back(EcfmpMeasure());
+        pilot.measures.back().ident = jsonMember(measure, "ident").asString();
+        pilot.measures.back().value = jsonMember(measure, "value").asInt();
+    }
+}
+
+/// @brief serializes the fields which are sent when a pilot is posted
+inline void serializePilot(const Pilot &pilot, Json::Value &root) {
+    forEachPilotField([&pilot, &root](auto index) {
+        constexpr const auto &field = pilotField<decltype(index)::value>();
+        if constexpr (true == field.posted) jsonTarget(root, field) = toJson<field.type>(pilot.*field.member);
+    });
+}
+
+/// @brief writes the patchable EuroScope fields which differ from the data of the backend into the message
+/// @return the number of changed fields
+inline int deltaPilot(const FlightplanData &euroscope, const FlightplanData &server, Json::Value &message) {
+    int deltaCount = 0;
+
+    forEachPilotField([&euroscope, &server, &message, &deltaCount](auto index) {
+        constexpr const auto &field = pilotField<decltype(index)::value>();
+        if constexpr (FieldSource::EuroScope == field.source && true == field.patchable) {
+            if (euroscope.*field.storage != server.*field.storage) {
+                jsonTarget(message, field) = toJson<field.type>(loadField(euroscope.*field.storage));
+                deltaCount += 1;
+            }
+        }
+    });
+
+    return deltaCount;
+}
+}  // namespace vacdm::types
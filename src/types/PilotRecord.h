@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Ecfmp.h"
+#include "Pilot.h"
+#include "PilotFields.h"
+
+namespace vacdm::types {
+/// @brief compact storage of a tracked pilot
+/// @details The A-CDM data is the base record, the EuroScope and backend data are overlays which only contain the
+/// fields that are provided by the source. The consolidated view is materialized on demand as types::Pilot.
+struct PilotRecord {
+    FixedString<16> callsign;
+    AcdmData acdm;
+    FlightplanData euroscope;
+    FlightplanData server;
+    bool hasServerData = false;
+    std::vector<EcfmpMeasure> measures;
+
+    PilotRecord() = default;
+    /// @brief creates the record of a new pilot, the A-CDM data is initialized with the flightplan data
+    explicit PilotRecord(const Pilot &euroscopePilot) {
+        this->callsign.assign(euroscopePilot.callsign);
+        this->euroscope.assign(euroscopePilot);
+        this->acdm.lastUpdate = euroscopePilot.lastUpdate;
+        this->acdm.eobt = euroscopePilot.eobt;
+        this->acdm.tobt = euroscopePilot.tobt;
+    }
+
+    void updateEuroscope(const Pilot &pilot) { this->euroscope.assign(pilot); }
+
+    /// @brief stores the backend data and replaces the A-CDM data with the data of the backend
+    void updateServer(const Pilot &pilot) {
+        this->server.assign(pilot);
+        this->hasServerData = true;
+
+        forEachPilotField([this, &pilot](auto index) {
+            constexpr const auto &field = pilotField<decltype(index)::value>();
+            if constexpr (FieldSource::Backend == field.source && true == isStored<decltype(index)::value>())
+                storeField(this->acdm.*field.storage, pilot.*field.member);
+        });
+
+        this->measures = pilot.measures;
+    }
+
+    /// @brief returns the consolidated data, i.e. the A-CDM data combined with the EuroScope position and flightplan
+    Pilot materialize() const {
+        Pilot pilot;
+        this->materialize(pilot);
+        return pilot;
+    }
+
+    /// @brief overwrites the pilot with the consolidated data
+    /// @details A pilot which is reused for every call keeps the capacity of its strings and measures and does not
+    /// allocate once it is warmed up.
+    void materialize(Pilot &pilot) const {
+        pilot.callsign.assign(this->callsign.view());
+        forEachPilotField([this, &pilot](auto index) {
+            constexpr const auto &field = pilotField<decltype(index)::value>();
+            if constexpr (FieldSource::EuroScope == field.source && true == isStored<decltype(index)::value>())
+                loadField(this->euroscope.*field.storage, pilot.*field.member);
+            else if constexpr (FieldSource::Backend == field.source && true == isStored<decltype(index)::value>())
+                loadField(this->acdm.*field.storage, pilot.*field.member);
+        });
+
+        // the backend decides if a pilot is inactive
+        pilot.inactive = this->server.inactive;
+        pilot.measures.assign(this->measures.begin(), this->measures.end());
+    }
+};
+}  // namespace vacdm::types
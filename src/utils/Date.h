@@ -2,10 +2,14 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
 
+// host tools like the relay are built without the EuroScope SDK
+#ifndef VACDM_NO_EUROSCOPE
 #pragma warning(push, 0)
 #include "EuroScopePlugIn.h"
 #pragma warning(pop)
+#endif
 
 #include "log/Logger.h"
 
@@ -19,6 +23,9 @@ class Date {
     Date &operator=(const Date &) = delete;
     Date &operator=(Date &&) = delete;
 
+    /// @brief ISO timestamp of times before the epoch, the backend resets a timestamp with this value
+    static constexpr std::string_view ResetTimestamp = "1969-12-31T23:59:59.999Z";
+
     /// @brief Converts std::chrono::utc_clock::time_point to an ISO-formatted string.
     ///
     /// This function takes a std::chrono::utc_clock::time_point and converts it to an
@@ -39,7 +46,7 @@ class Date {
             timestamp = timestamp.substr(0, timestamp.length() - 4) + "Z";
             return timestamp;
         } else {
-            return "1969-12-31T23:59:59.999Z";
+            return std::string(ResetTimestamp);
         }
     }
 
@@ -64,6 +71,7 @@ class Date {
         return retval;
     }
 
+#ifndef VACDM_NO_EUROSCOPE
     /// @brief Converts a EuroScope departure time string to a UTC time_point.
     /// This function takes a EuroScope flight plan and extracts the estimated departure time string.
     /// Using a different util function it then convert the string to a utc time_point
@@ -78,6 +86,7 @@ class Date {
 
         return convertStringToTimePoint(eobt);
     }
+#endif
     /// @brief Converts a 4-character HHMM string to a UTC time_point.
     /// This function takes a 4-character string representing time in HHMM format.
     /// If the string is not valid (empty or exceeds 4 characters), the function returns the
@@ -69,6 +69,21 @@ class String {
         });
     }
 
+    /**
+     * @brief Concatenates the values and inserts the separator between them
+     * @param[in] values The strings which need to be joined
+     * @param[in] separator The separator between two values
+     * @return The joined string
+     */
+    static auto join(const std::vector<std::string> &values, const std::string &separator) -> std::string {
+        std::string result;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (0 != i) result += separator;
+            result += values[i];
+        }
+        return result;
+    }
+
     /**
      * @brief Removes leading and trailing whitespaces
      * @param[in] value The trimmable string
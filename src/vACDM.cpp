@@ -3,6 +3,7 @@
 #include <Windows.h>
 #include <shlwapi.h>
 
+#include <algorithm>
 #include <numeric>
 
 #include "Version.h"
@@ -19,6 +20,9 @@
 
 EXTERN_C IMAGE_DOS_HEADER __ImageBase;
 
+// minimum number of flightplans per tick of the reconciliation sweep
+static constexpr std::size_t __minimumSweepSlice = 8;
+
 using namespace vacdm;
 using namespace vacdm::com;
 using namespace vacdm::core;
@@ -40,10 +44,16 @@ vACDM::vACDM()
     PathRemoveFileSpecA(path);
     this->m_dllPath = std::string(path);
 
+    // writes which could not be delivered in the last session are replayed when the backend is reachable
+    Server::instance().openOutbox(this->m_dllPath + "\\vacdm_outbox.bin");
+
     this->RegisterTagItemTypes();
     this->RegisterTagItemFuntions();
 
     this->reloadConfiguration(true);
+
+    // show the pilots of the last session until the first update cycle is finished
+    DataManager::instance().enableSnapshot(this->m_dllPath + "\\vacdm_snapshot.bin");
 }
 
 vACDM::~vACDM() {}
@@ -65,9 +75,39 @@ void vACDM::checkServerConfiguration() {
 }
 
 void vACDM::runEuroscopeUpdate() {
-    for (EuroScopePlugIn::CFlightPlan flightplan = FlightPlanSelectFirst(); flightplan.IsValid();
-         flightplan = FlightPlanSelectNext(flightplan)) {
+    EuroScopePlugIn::CFlightPlan flightplan;
+    if (true == this->m_sweepCursor.empty()) {
+        flightplan = this->FlightPlanSelectFirst();
+
+        // the first sweep has no size yet, count the flightplans to spread it over the interval as well
+        if (0 == this->m_lastSweepSize) {
+            for (auto counted = flightplan; true == counted.IsValid(); counted = this->FlightPlanSelectNext(counted))
+                this->m_lastSweepSize += 1;
+        }
+    } else {
+        // continue after the last handled flightplan, restart the sweep if it has been removed in the meantime
+        flightplan = this->FlightPlanSelect(this->m_sweepCursor.c_str());
+        flightplan = flightplan.IsValid() ? this->FlightPlanSelectNext(flightplan) : this->FlightPlanSelectFirst();
+    }
+
+    // spread the sweep over the reconciliation interval, based on the number of flightplans of the last sweep
+    const auto interval = static_cast<std::size_t>(this->m_pluginConfig.reconciliationSeconds);
+    const auto sliceSize =
+        std::max<std::size_t>(__minimumSweepSlice, (this->m_lastSweepSize + interval - 1) / interval);
+
+    std::size_t handled = 0;
+    for (; true == flightplan.IsValid() && handled < sliceSize; flightplan = this->FlightPlanSelectNext(flightplan)) {
         DataManager::instance().queueFlightplanUpdate(flightplan);
+        this->m_sweepCursor = flightplan.GetCallsign();
+        handled += 1;
+    }
+    this->m_sweepSize += handled;
+
+    // the end of the list is reached, the next tick starts a new sweep
+    if (false == flightplan.IsValid()) {
+        this->m_lastSweepSize = this->m_sweepSize;
+        this->m_sweepSize = 0;
+        this->m_sweepCursor.clear();
     }
 }
 
@@ -99,31 +139,47 @@ void vACDM::reloadConfiguration(bool initialLoading) {
         DisplayMessage(message, "Config");
     } else {
         DisplayMessage(true == initialLoading ? "Loaded the config" : "Reloaded the config", "Config");
-        if (this->m_pluginConfig.serverUrl != newConfig.serverUrl)
-            this->changeServerUrl(newConfig.serverUrl);
+        if (this->m_pluginConfig.serverUrl != newConfig.serverUrl ||
+            this->m_pluginConfig.serverMirrors != newConfig.serverMirrors)
+            this->changeServerUrl(newConfig.serverUrl, newConfig.serverMirrors);
         else
             this->checkServerConfiguration();
 
         this->m_pluginConfig = newConfig;
-        DisplayMessage(DataManager::instance().setUpdateCycleSeconds(newConfig.updateCycleSeconds));
+        if (true == newConfig.adaptiveUpdateCycle)
+            DisplayMessage(DataManager::instance().setAdaptiveUpdateCycle(
+                std::chrono::milliseconds(newConfig.minUpdateCycleMilliseconds),
+                std::chrono::milliseconds(newConfig.maxUpdateCycleMilliseconds)));
+        else
+            DisplayMessage(
+                DataManager::instance().setUpdateCycle(std::chrono::milliseconds(newConfig.updateCycleMilliseconds)));
+        if (true == newConfig.pushChannel)
+            DataManager::instance().enablePushChannel(
+                false == newConfig.pushUrl.empty() ? newConfig.pushUrl : newConfig.serverUrl + "/api/v1/pilots/stream",
+                std::chrono::seconds(newConfig.pushConsistencySeconds));
+        else
+            DataManager::instance().disablePushChannel();
         tagitems::Color::updatePluginConfig(newConfig);
     }
 }
 
-void vACDM::changeServerUrl(const std::string &url) {
+void vACDM::changeServerUrl(const std::string &url, const std::vector<std::string> &mirrors) {
     DataManager::instance().pause();
-    Server::instance().changeServerAddress(url);
+    Server::instance().changeServerAddress(url, mirrors);
     this->checkServerConfiguration();
 
     DataManager::instance().resume();
-    DisplayMessage("Changed URL to " + url);
-    Logger::instance().log(Logger::LogSender::vACDM, "Changed URL to " + url, Logger::LogLevel::Info);
+    const auto message =
+        "Changed URL to " + url + (mirrors.empty() ? "" : " with " + std::to_string(mirrors.size()) + " mirrors");
+    DisplayMessage(message);
+    Logger::instance().log(Logger::LogSender::vACDM, message, Logger::LogLevel::Info);
 }
 
 // Euroscope Events:
 
-void vACDM::OnTimer(int Counter) {
-    if (Counter % 5 == 0) this->runEuroscopeUpdate();
+void vACDM::OnTimer(int) {
+    // the callbacks deliver the changes, the sweep only reconciles missed updates
+    this->runEuroscopeUpdate();
 }
 
 void vACDM::OnFlightPlanFlightPlanDataUpdate(EuroScopePlugIn::CFlightPlan FlightPlan) {
@@ -140,8 +196,13 @@ void vACDM::OnFlightPlanControllerAssignedDataUpdate(EuroScopePlugIn::CFlightPla
     DataManager::instance().queueFlightplanUpdate(FlightPlan);
 }
 
+void vACDM::OnRadarTargetPositionUpdate(EuroScopePlugIn::CRadarTarget RadarTarget) {
+    const auto flightplan = RadarTarget.GetCorrelatedFlightPlan();
+    if (true == flightplan.IsValid()) DataManager::instance().queueFlightplanUpdate(flightplan);
+}
+
 void vACDM::OnAirportRunwayActivityChanged() {
-    std::list<std::string> activeAirports;
+    std::vector<std::string> airportICAOs;
 
     EuroScopePlugIn::CSectorElement airport;
     for (airport = this->SectorFileElementSelectFirst(EuroScopePlugIn::SECTOR_ELEMENT_AIRPORT);
@@ -155,24 +216,24 @@ void vACDM::OnAirportRunwayActivityChanged() {
         // skip airport if no ICAO has been found
         if (airportICAO == "") continue;
 
-        // check if the airport has been added already, add if it does not exist
-        if (std::find(activeAirports.begin(), activeAirports.end(), airportICAO) == activeAirports.end()) {
-            activeAirports.push_back(airportICAO);
-        }
+        // duplicates are removed by the airport set
+        airportICAOs.push_back(airportICAO);
     }
 
-    if (activeAirports.empty()) {
+    AirportSet activeAirports(airportICAOs);
+    const auto &names = activeAirports.names();
+    if (names.empty()) {
         Logger::instance().log(Logger::LogSender::vACDM,
                                "Airport/Runway Change, no active airports: ", Logger::LogLevel::Info);
     } else {
         Logger::instance().log(
             Logger::LogSender::vACDM,
             "Airport/Runway Change, active airports: " +
-                std::accumulate(std::next(activeAirports.begin()), activeAirports.end(), activeAirports.front(),
+                std::accumulate(std::next(names.begin()), names.end(), names.front(),
                                 [](const std::string &acc, const std::string &str) { return acc + " " + str; }),
             Logger::LogLevel::Info);
     }
-    DataManager::instance().setActiveAirports(activeAirports);
+    DataManager::instance().setActiveAirports(std::move(activeAirports));
 }
 
 }  // namespace vacdm
\ No newline at end of file
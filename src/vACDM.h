@@ -1,12 +1,14 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #pragma warning(push, 0)
 #include "EuroScopePlugIn.h"
 #pragma warning(pop)
 
 #include "config/ConfigParser.h"
+#include "types/Pilot.h"
 
 namespace vacdm {
 
@@ -23,6 +25,7 @@ class vACDM : public EuroScopePlugIn::CPlugIn {
     void OnTimer(int Counter) override;
     void OnFlightPlanFlightPlanDataUpdate(EuroScopePlugIn::CFlightPlan FlightPlan) override;
     void OnFlightPlanControllerAssignedDataUpdate(EuroScopePlugIn::CFlightPlan FlightPlan, int DataType) override;
+    void OnRadarTargetPositionUpdate(EuroScopePlugIn::CRadarTarget RadarTarget) override;
     void OnFunctionCall(int functionId, const char *itemString, POINT pt, RECT area) override;
     void OnGetTagItem(EuroScopePlugIn::CFlightPlan FlightPlan, EuroScopePlugIn::CRadarTarget RadarTarget, int ItemCode,
                       int TagData, char sItemString[16], int *pColorCode, COLORREF *pRGB, double *pFontSize) override;
@@ -32,8 +35,16 @@ class vACDM : public EuroScopePlugIn::CPlugIn {
     std::string m_dllPath;
     std::string m_configFileName = "\\vacdm.txt";
     PluginConfig m_pluginConfig;
-    void changeServerUrl(const std::string &url);
+    /// @brief reused by every tag item, the pilot keeps its capacity and the lookups do not allocate
+    types::Pilot m_tagItemPilot;
 
+    // state of the reconciliation sweep, the callsign of the last handled flightplan and the number of flightplans
+    std::string m_sweepCursor;
+    std::size_t m_sweepSize = 0;
+    std::size_t m_lastSweepSize = 0;
+    void changeServerUrl(const std::string &url, const std::vector<std::string> &mirrors);
+
+    /// @brief queues the next slice of the reconciliation sweep over all flightplans
     void runEuroscopeUpdate();
     void checkServerConfiguration();
     void reloadConfiguration(bool initialLoading = false);